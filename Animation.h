@@ -36,11 +36,198 @@ SOFTWARE.
 #define EC_DEFAULT_UPDATE_PERIOD 10
 #endif
 
+#ifndef EC_ENABLE_PROFILING
+/** Measure the processing time of every Animation in an AnimationScene.
+ * Costs 2 micros() calls per Animation and some RAM, so it's disabled by default.
+ * @see AnimationProfile
+ */
+#define EC_ENABLE_PROFILING 0
+#endif
+
+#ifndef EC_ENABLE_FRAME_STATS
+/** Let the FrameClock of every AnimationScene count how late its AnimationTimers were triggered.
+ * Costs some RAM per AnimationScene, so it's disabled by default.
+ * @see FrameStats
+ */
+#define EC_ENABLE_FRAME_STATS 0
+#endif
+
+#ifndef EC_TIMER_MAX_CATCH_UP
+/** How many missed update periods an AnimationTimer shall catch up, when it is processed too late.
+ * 0 (the default) skips all missed periods, i.e. the timer triggers only once and then continues
+ * on its original phase. With N > 0, the timer triggers on each of the following calls until it
+ * has caught up with up to N missed periods (e.g. for keeping a Model's speed when the main loop
+ * stalls); beyond that, the rest is skipped.
+ */
+#define EC_TIMER_MAX_CATCH_UP 0
+#endif
+
+#if (EC_ENABLE_PROFILING) && defined(__GXX_RTTI)
+#include <typeinfo>
+#endif
+
 //------------------------------------------------------------------------------
 
 namespace EC
 {
 
+#if (EC_ENABLE_PROFILING)
+  /** Processing time statistics of an Animation within an AnimationScene.
+   * Only available when EC_ENABLE_PROFILING is enabled.
+   */
+  struct AnimationProfile
+  {
+    /// Number of process() calls.
+    uint32_t calls = 0;
+
+    /// Total processing time of all calls (in µs).
+    uint32_t totalMicros = 0;
+
+    /// Shortest processing time (in µs).
+    uint32_t minMicros = 0xFFFFFFFF;
+
+    /// Longest processing time (in µs).
+    uint32_t maxMicros = 0;
+
+    /// Average processing time (in µs).
+    uint32_t meanMicros() const { return calls ? totalMicros / calls : 0; }
+
+    /// Add the processing time \a micros of a single call.
+    void add(uint32_t micros)
+    {
+      ++calls;
+      totalMicros += micros;
+      if (micros < minMicros)
+      {
+        minMicros = micros;
+      }
+      if (micros > maxMicros)
+      {
+        maxMicros = micros;
+      }
+    }
+
+    /// Start over.
+    void reset() { *this = AnimationProfile(); }
+  };
+#endif
+
+#if (EC_ENABLE_FRAME_STATS)
+  /** Timing statistics of the AnimationTimers within an AnimationScene.
+   * Only available when EC_ENABLE_FRAME_STATS is enabled.
+   * @see FrameClock
+   */
+  struct FrameStats
+  {
+    /// Number of AnimationTimer deadlines, i.e. how often they were triggered.
+    uint32_t deadlines = 0;
+
+    /// Number of deadlines where the AnimationTimer was triggered too late.
+    uint32_t lateDeadlines = 0;
+
+    /// Number of update periods that were skipped completely.
+    uint32_t missedDeadlines = 0;
+
+    /// Total lateness of all late deadlines (in ms).
+    uint32_t totalLateMillis = 0;
+
+    /// Largest lateness (in ms).
+    uint32_t maxLateMillis = 0;
+
+    /// Average lateness of the late deadlines (in ms), i.e. the jitter of the late frames.
+    uint32_t meanLateMillis() const { return lateDeadlines ? totalLateMillis / lateDeadlines : 0; }
+
+    /** Add a single deadline.
+     * @param lateMillis  How late (in ms) the AnimationTimer was triggered.
+     * @param missedPeriods  Number of update periods that were skipped.
+     */
+    void add(uint32_t lateMillis, uint32_t missedPeriods)
+    {
+      ++deadlines;
+      missedDeadlines += missedPeriods;
+      if (lateMillis)
+      {
+        ++lateDeadlines;
+        totalLateMillis += lateMillis;
+        if (lateMillis > maxLateMillis)
+        {
+          maxLateMillis = lateMillis;
+        }
+      }
+    }
+
+    /// Start over.
+    void reset() { *this = FrameStats(); }
+
+    /// Print the statistics in one line, e.g. to Serial.
+    void print(Print &out) const
+    {
+      out.print(F("deadlines="));
+      out.print(deadlines);
+      out.print(F(" late="));
+      out.print(lateDeadlines);
+      out.print(F(" missed="));
+      out.print(missedDeadlines);
+      out.print(F(" meanLate="));
+      out.print(meanLateMillis());
+      out.print(F(" maxLate="));
+      out.print(maxLateMillis);
+      out.println(F("ms"));
+    }
+  };
+#endif
+
+  //------------------------------------------------------------------------------
+
+  /** Common time base for all Animations of an AnimationScene.
+   * The Animations don't get the current time directly, but the time of the current frame,
+   * which advances in steps of \a tickMillis. Thereby all AnimationTimers of a scene are
+   * aligned to the same tick, and those with commensurable update periods (like 10ms and
+   * 20ms) always trigger within the same frame, instead of causing separate partial frames.
+   * All calculations are based on time differences, so they also work when millis() wraps around.
+   */
+  class FrameClock
+  {
+  public:
+    /** Length (in ms) of one tick of the frame clock.
+     * 1 (the default) just passes the current time, i.e. the AnimationTimers are only aligned
+     * by keeping their phase. Should be a divisor of the update periods, e.g. 10 for
+     * EC_DEFAULT_UPDATE_PERIOD.
+     */
+    uint8_t tickMillis = 1;
+
+#if (EC_ENABLE_FRAME_STATS)
+    /// Timing statistics of all AnimationTimers that were triggered within the scene.
+    FrameStats stats;
+
+    /// The FrameClock of the AnimationScene that is currently being processed (if any).
+    static FrameClock *&active()
+    {
+      static FrameClock *activeClock = nullptr;
+      return activeClock;
+    }
+#endif
+
+    /** Time of the frame that contains \a currentMillis.
+     * Must be called with monotonically increasing time values.
+     */
+    uint32_t frameMillis(uint32_t currentMillis)
+    {
+      if (tickMillis > 1)
+      {
+        const uint32_t elapsedMillis = currentMillis - _frameMillis;
+        _frameMillis += elapsedMillis - elapsedMillis % tickMillis;
+        return _frameMillis;
+      }
+      return currentMillis;
+    }
+
+  private:
+    uint32_t _frameMillis = 0;
+  };
+
+  //------------------------------------------------------------------------------
+
   /** Interface for all EyeCandy Animations.
    * Call one of the process() methods frequently from your sketch's loop()
    * function.
@@ -109,6 +296,70 @@ namespace EC
       processAnimation(currentMillis, wasModified);
     }
 
+    /// Maximum return value of getIdleMillis(); the Animation doesn't get active on its own.
+    static constexpr uint16_t IDLE_MAX = 0xFFFF;
+
+    /** Time (in ms) until this Animation must be processed again.
+     * Until then, process() would neither change the LED strip nor the Animation's state -
+     * unless the LED strip was modified by a previous Animation (which triggers the Overlays).
+     * A sketch can use this e.g. for sleeping until the next frame is due:
+     * @code
+     * if (animation.process()) FastLED.show();
+     * delay(min(animation.getIdleMillis(millis()), 10));
+     * @endcode
+     * The default implementation returns 0, i.e. the Animation must be processed on every call.
+     * @param currentMillis  Current time, i.e. the returnvalue of millis().
+     */
+    virtual uint16_t getIdleMillis(uint32_t currentMillis)
+    {
+      return 0;
+    }
+
+#if (EC_ENABLE_PROFILING)
+    /** Name of this Animation in the profiling report.
+     * Assign e.g. a string literal; when not set, the class name is used (if RTTI is available).
+     */
+    const char *profileTag = nullptr;
+
+    /// Processing time statistics (only when part of an AnimationScene).
+    AnimationProfile profile;
+
+    /// Name of this Animation in the profiling report.
+    virtual const char *getProfileTag() const
+    {
+      if (profileTag)
+      {
+        return profileTag;
+      }
+#if defined(__GXX_RTTI)
+      return typeid(*this).name();
+#else
+      return "?";
+#endif
+    }
+
+    /** Print one line of the profiling report.
+     * @param out  Print here, e.g. to Serial.
+     * @param position  Position within the AnimationScene.
+     */
+    void printProfile(Print &out, uint8_t position) const
+    {
+      out.print(position);
+      out.print(F(": calls="));
+      out.print(profile.calls);
+      out.print(F(" mean="));
+      out.print(profile.meanMicros());
+      out.print(F(" min="));
+      out.print(profile.calls ? profile.minMicros : 0);
+      out.print(F(" max="));
+      out.print(profile.maxMicros);
+      out.print(F(" total="));
+      out.print(profile.totalMicros);
+      out.print(F("us "));
+      out.println(getProfileTag());
+    }
+#endif
+
   protected:
     Animation() = default;
 
@@ -123,9 +374,157 @@ namespace EC
     virtual void processAnimation(uint32_t currentMillis, bool &wasModified) = 0;
 
   private:
-    friend class AnimationScene;
-    friend class AnimationSceneStatic;
+    friend class AnimationSceneBase;
     Animation *nextAnimation = nullptr;
+
+    /// Process this Animation as part of an AnimationScene.
+    void processNode(uint32_t currentMillis, bool &wasModified)
+    {
+#if (EC_ENABLE_PROFILING)
+      const uint32_t startMicros = micros();
+      processAnimation(currentMillis, wasModified);
+      profile.add(micros() - startMicros);
+#else
+      processAnimation(currentMillis, wasModified);
+#endif
+    }
+  };
+
+  //------------------------------------------------------------------------------
+
+  /** Common part of AnimationScene and AnimationSceneStatic.
+   * Holds the list of Animations, processes them in the order as they were appended,
+   * and skips them altogether while all of them are idle.
+   */
+  class AnimationSceneBase
+      : public Animation
+  {
+  public:
+    /** Time (in ms) until any of the Animations must be processed again.
+     * Until then, process() skips walking through the Animations (unless the LED strip was
+     * already modified by a previous Animation).
+     * @see Animation::getIdleMillis()
+     */
+    uint16_t getIdleMillis(uint32_t currentMillis) override
+    {
+      const uint32_t elapsedMillis = currentMillis - _lastProcessMillis;
+      return (elapsedMillis < _idleMillis) ? _idleMillis - elapsedMillis : 0;
+    }
+
+    /** Process all Animations with the next call, even when they reported to be idle.
+     * Call this after changing an Animation's settings that affect its timing.
+     */
+    void wakeUp() { _idleMillis = 0; }
+
+    /// Time base for all Animations of this scene.
+    FrameClock frameClock;
+
+#if (EC_ENABLE_PROFILING)
+    /** Walk through the profiling data of all Animations of this AnimationScene.
+     * @param visitor  Called with the position (0 = first appended) and the Animation,
+     *                 e.g. <tt>[](uint8_t position, const Animation &animation) {...}</tt>
+     */
+    template <class Visitor>
+    void forEachProfile(Visitor visitor) const
+    {
+      uint8_t position = 0;
+      for (const Animation *animation = _animationListHead; animation; animation = animation->nextAnimation)
+      {
+        visitor(position++, *animation);
+      }
+    }
+
+    /// Print the profiling report of all Animations, e.g. to Serial.
+    void printProfile(Print &out) const
+    {
+      forEachProfile([&out](uint8_t position, const Animation &animation)
+                     { animation.printProfile(out, position); });
+    }
+
+    /// Reset the profiling data of all Animations.
+    void resetProfile()
+    {
+      for (Animation *animation = _animationListHead; animation; animation = animation->nextAnimation)
+      {
+        animation->profile.reset();
+      }
+    }
+#endif
+
+  protected:
+    AnimationSceneBase() = default;
+
+    /// Append \a animation to the end of the list.
+    void storeAnimation(Animation *animation)
+    {
+      wakeUp();
+      Animation **tailPtr = &_animationListHead;
+      while (*tailPtr)
+      {
+        tailPtr = &(*tailPtr)->nextAnimation;
+      }
+      *tailPtr = animation;
+    }
+
+    /// Remove the first Animation from the list; \c nullptr when the list is empty.
+    Animation *removeFirstAnimation()
+    {
+      Animation *animation = _animationListHead;
+      if (animation)
+      {
+        _animationListHead = animation->nextAnimation;
+        animation->nextAnimation = nullptr;
+      }
+      return animation;
+    }
+
+    /// Exchange all Animations with the \a other scene.
+    void swapAnimations(AnimationSceneBase &other)
+    {
+      Animation *animationListHead = _animationListHead;
+      _animationListHead = other._animationListHead;
+      other._animationListHead = animationListHead;
+      wakeUp();
+      other.wakeUp();
+    }
+
+  private:
+    /// @see Animation::processAnimation()
+    void processAnimation(uint32_t currentMillis, bool &wasModified) override
+    {
+      if (!wasModified && currentMillis - _lastProcessMillis < _idleMillis)
+      {
+        return;
+      }
+
+      const uint32_t frameMillis = frameClock.frameMillis(currentMillis);
+#if (EC_ENABLE_FRAME_STATS)
+      FrameClock *const outerClock = FrameClock::active();
+      FrameClock::active() = &frameClock;
+#endif
+      uint16_t idleMillis = IDLE_MAX;
+      Animation *animation = _animationListHead;
+      while (animation)
+      {
+        animation->processNode(frameMillis, wasModified);
+        const uint16_t animationIdleMillis = animation->getIdleMillis(frameMillis);
+        if (animationIdleMillis < idleMillis)
+        {
+          idleMillis = animationIdleMillis;
+        }
+        animation = animation->nextAnimation;
+      }
+#if (EC_ENABLE_FRAME_STATS)
+      FrameClock::active() = outerClock;
+#endif
+      _lastProcessMillis = frameMillis;
+      _idleMillis = idleMillis;
+    }
+
+  private:
+    Animation *_animationListHead = nullptr;
+    uint32_t _lastProcessMillis = 0;
+    uint16_t _idleMillis = 0;
   };
 
   //------------------------------------------------------------------------------
@@ -142,7 +541,7 @@ namespace EC
    * destroy them accordingly.
    */
   class AnimationScene
-      : public Animation
+      : public AnimationSceneBase
   {
   public:
     /// Destructor. Also destroys all previously added Animations.
@@ -171,7 +570,8 @@ namespace EC
     template <class AnimationType>
     AnimationType *append(AnimationType &animation)
     {
-      storeAnimation(new Proxy(animation));
+      _proxyListHead = new Proxy(animation, _proxyListHead);
+      storeAnimation(_proxyListHead);
       return &animation;
     }
 
@@ -181,57 +581,90 @@ namespace EC
      */
     void reset()
     {
-      while (_animationListHead)
+      while (Animation *toDelete = removeFirstAnimation())
       {
-        Animation *toDelete = _animationListHead;
-        _animationListHead = _animationListHead->nextAnimation;
         delete toDelete;
       }
+      _proxyListHead = nullptr;
+    }
+
+    /** Exchange all Animations with the \a other AnimationScene.
+     * Useful for keeping an AnimationScene that was set up in the background.
+     */
+    void swap(AnimationScene &other)
+    {
+      swapAnimations(other);
+      Proxy *proxyListHead = _proxyListHead;
+      _proxyListHead = other._proxyListHead;
+      other._proxyListHead = proxyListHead;
+    }
+
+    /** Stop processing the static Animations that were also appended to the \a other AnimationScene.
+     * When both AnimationScenes are running at the same time (e.g. during a crossfade), such a
+     * shared Animation (like a static VuSource) would otherwise be processed twice per frame,
+     * and e.g. its peak decay would run twice as fast. Now only the \a other AnimationScene
+     * processes it; Animations of this AnimationScene still see its results, but they are
+     * one frame behind. This lasts until reset().
+     */
+    void skipSharedAnimations(const AnimationScene &other)
+    {
+      for (Proxy *proxy = _proxyListHead; proxy; proxy = proxy->_nextProxy)
+      {
+        for (const Proxy *otherProxy = other._proxyListHead; otherProxy; otherProxy = otherProxy->_nextProxy)
+        {
+          if (&otherProxy->_staticAnimation == &proxy->_staticAnimation)
+          {
+            proxy->_skipped = true;
+          }
+        }
+      }
+      wakeUp();
     }
 
     class Proxy : public Animation
     {
+      friend class AnimationScene;
       Animation &_staticAnimation;
+      Proxy *_nextProxy;
+      bool _skipped = false;
+
       void processAnimation(uint32_t currentMillis, bool &wasModified) override
       {
-        _staticAnimation.process(currentMillis, wasModified);
+        if (!_skipped)
+        {
+          _staticAnimation.process(currentMillis, wasModified);
+        }
       }
 
     public:
-      explicit Proxy(Animation &staticAnimation) : _staticAnimation(staticAnimation) {}
-    };
+      Proxy(Animation &staticAnimation, Proxy *nextProxy)
+          : _staticAnimation(staticAnimation), _nextProxy(nextProxy)
+      {
+      }
 
-  private:
-    /// @see Animation::processAnimation()
-    void processAnimation(uint32_t currentMillis, bool &wasModified) override
-    {
-      Animation *animation = _animationListHead;
-      while (animation)
+      uint16_t getIdleMillis(uint32_t currentMillis) override
       {
-        animation->process(currentMillis, wasModified);
-        animation = animation->nextAnimation;
+        return _skipped ? IDLE_MAX : _staticAnimation.getIdleMillis(currentMillis);
       }
-    }
 
-    void storeAnimation(Animation *animation)
-    {
-      Animation **tailPtr = &_animationListHead;
-      while (*tailPtr)
+#if (EC_ENABLE_PROFILING)
+      const char *getProfileTag() const override
       {
-        tailPtr = &(*tailPtr)->nextAnimation;
+        return profileTag ? profileTag : _staticAnimation.getProfileTag();
       }
-      *tailPtr = animation;
-    }
+#endif
+    };
 
   private:
-    Animation *_animationListHead = nullptr;
+    /// All static Animations, for skipSharedAnimations().
+    Proxy *_proxyListHead = nullptr;
   };
 
   //------------------------------------------------------------------------------
 
   /// Same as AnimationScene, but the Animations must \e not be allocated on the heap.
   class AnimationSceneStatic
-      : public Animation
+      : public AnimationSceneBase
   {
   public:
     /// Destructor. Also removes all previously added Animations.
@@ -256,38 +689,10 @@ namespace EC
      */
     void reset()
     {
-      while (_animationListHead)
-      {
-        Animation *toClear = _animationListHead;
-        _animationListHead = _animationListHead->nextAnimation;
-        toClear->nextAnimation = nullptr;
-      }
-    }
-
-  private:
-    /// @see Animation::processAnimation()
-    void processAnimation(uint32_t currentMillis, bool &wasModified) override
-    {
-      Animation *animation = _animationListHead;
-      while (animation)
-      {
-        animation->process(currentMillis, wasModified);
-        animation = animation->nextAnimation;
-      }
-    }
-
-    void storeAnimation(Animation *animation)
-    {
-      Animation **tailPtr = &_animationListHead;
-      while (*tailPtr)
+      while (removeFirstAnimation())
       {
-        tailPtr = &(*tailPtr)->nextAnimation;
       }
-      *tailPtr = animation;
     }
-
-  private:
-    Animation *_animationListHead = nullptr;
   };
 
   //------------------------------------------------------------------------------
@@ -311,24 +716,71 @@ namespace EC
     }
 
     /** Call this method periodically.
+     * The timer keeps its phase, i.e. when it is triggered late, the next deadline is still
+     * one update period after the previous one (and not after \a currentMillis). How missed
+     * update periods are handled depends on EC_TIMER_MAX_CATCH_UP.
      * @retval \c true Timer triggered; caller shall execute its corresponding action.
      * @retval \c false Nothing to do.
      */
     bool process(uint32_t currentMillis)
     {
-      if (updatePeriod)
+      if (!updatePeriod)
       {
-        if (currentMillis >= _nextUpdate)
-        {
-          _nextUpdate = currentMillis + updatePeriod;
-          return true;
-        }
+        _nextUpdate = NOT_RUNNING;
+        return false;
+      }
+
+      if (_nextUpdate == NOT_RUNNING)
+      {
+        schedule(currentMillis + updatePeriod);
+        return true;
+      }
+
+      // Signed difference, so that it also works when millis() wraps around.
+      const int32_t lateMillis = int32_t(currentMillis - _nextUpdate);
+      if (lateMillis < 0)
+      {
+        return false;
       }
-      return false;
+
+      uint32_t missedPeriods = 0;
+      if (uint32_t(lateMillis) >= uint32_t(updatePeriod) * (EC_TIMER_MAX_CATCH_UP + 1))
+      {
+        missedPeriods = uint32_t(lateMillis) / updatePeriod - EC_TIMER_MAX_CATCH_UP;
+      }
+      schedule(_nextUpdate + (missedPeriods + 1) * updatePeriod);
+
+#if (EC_ENABLE_FRAME_STATS)
+      if (FrameClock::active())
+      {
+        FrameClock::active()->stats.add(lateMillis, missedPeriods);
+      }
+#endif
+      return true;
+    }
+
+    /// Time (in ms) until process() will return \c true again; Animation::IDLE_MAX when suspended.
+    uint16_t getIdleMillis(uint32_t currentMillis) const
+    {
+      if (!updatePeriod)
+      {
+        return Animation::IDLE_MAX;
+      }
+      const int32_t remainingMillis = int32_t(_nextUpdate - currentMillis);
+      return (_nextUpdate != NOT_RUNNING && remainingMillis > 0) ? remainingMillis : 0;
     }
 
   private:
-    uint32_t _nextUpdate = 0;
+    /// Value of _nextUpdate before the first process() call, and while suspended.
+    static constexpr uint32_t NOT_RUNNING = 0;
+
+    /// Set the next deadline; a deadline that collides with NOT_RUNNING is delayed by 1ms.
+    void schedule(uint32_t nextUpdate)
+    {
+      _nextUpdate = (nextUpdate != NOT_RUNNING) ? nextUpdate : NOT_RUNNING + 1;
+    }
+
+    uint32_t _nextUpdate = NOT_RUNNING;
   };
 
 } // namespace EC
@@ -48,6 +48,12 @@ namespace EC
      */
     uint16_t getPatternUpdatePeriod() { return _patternUpdateTimer.updatePeriod; }
 
+    /// @see Animation::getIdleMillis()
+    uint16_t getIdleMillis(uint32_t currentMillis) override
+    {
+      return _patternUpdateTimer.getIdleMillis(currentMillis);
+    }
+
     /// Only for debugging.
     FastLedStrip getStrip() { return strip; }
 
@@ -199,6 +205,14 @@ namespace EC
      */
     uint16_t getModelUpdatePeriod() { return _modelUpdateTimer.updatePeriod; }
 
+    /// @see Animation::getIdleMillis()
+    uint16_t getIdleMillis(uint32_t currentMillis) override
+    {
+      const uint16_t patternIdleMillis = AnimationBase::getIdleMillis(currentMillis);
+      const uint16_t modelIdleMillis = _modelUpdateTimer.getIdleMillis(currentMillis);
+      return (modelIdleMillis < patternIdleMillis) ? modelIdleMillis : patternIdleMillis;
+    }
+
   protected:
     /** Constructor.
      * @param modelUpdatePeriod  Period (in ms) for calling updateModel().
@@ -27,6 +27,7 @@ SOFTWARE.
 
 #include <FastLED.h>
 #include "Animation.h"
+#include "PixelKernels.h"
 #include "SetupEnv.h"
 
 //------------------------------------------------------------------------------
@@ -80,6 +81,12 @@ namespace EC
       return retval;
     }
 
+    /// @see Animation::getIdleMillis()
+    uint16_t getIdleMillis(uint32_t currentMillis) override
+    {
+      return _setupEnv.scene().getIdleMillis(currentMillis);
+    }
+
   private:
     /// @see Animation::processAnimation()
     void processAnimation(uint32_t currentMillis, bool &wasModified) override
@@ -96,7 +103,8 @@ namespace EC
   //------------------------------------------------------------------------------
 
   /** Helper class for cycling through different Animation Scenes.
-   * Implements a soft fade-out / fade-in effect when changing the Animation.
+   * Implements a soft fade-out / fade-in effect when changing the Animation,
+   * or optionally a crossfade from the old to the new Animation.
    * @note This class controls the overall brightness of the LED strip via
    * FastLED.setBrightness()
    */
@@ -114,6 +122,16 @@ namespace EC
      */
     uint16_t fadingDuration = 1000;
 
+    /** Crossfade from the old to the new AnimationScene, instead of fading out to black and in again.
+     * During the crossfade both AnimationScenes are running, and are blended over fadingDuration.
+     * This needs 2 extra buffers of the LED strip's size and a second AnimationScene; they are
+     * allocated with the first crossfade and kept for all further ones.
+     * Static Animations that both AnimationScenes share (like a VuSource) are processed only once
+     * per frame, see AnimationScene::skipSharedAnimations().
+     * This setting can be adjusted at runtime; it takes effect with the next change.
+     */
+    bool crossfade = false;
+
     /** Constructor.
      * @param setupEnv  Setup environment for Animation Scenes.
      * @param allAnimations  Array with all functions that set up an AnimationScene.
@@ -127,6 +145,13 @@ namespace EC
       selectFirst();
     }
 
+    /// Destructor.
+    ~AnimationChangerSoft()
+    {
+      delete _incomingScene;
+      delete[] _crossfadeBuffers;
+    }
+
     /// Select the first AnimationScene.
     void selectFirst()
     {
@@ -151,12 +176,145 @@ namespace EC
       return retval;
     }
 
+    /// @see Animation::getIdleMillis()
+    uint16_t getIdleMillis(uint32_t currentMillis) override
+    {
+      if (_nextAnimationBuilder || _crossfading || _fadingStartTime)
+      {
+        // fading is done on every call
+        return 0;
+      }
+      return _setupEnv.scene().getIdleMillis(currentMillis);
+    }
+
   private:
     /// @see Animation::processAnimation()
     void processAnimation(uint32_t currentMillis, bool &wasModified) override
     {
-      _setupEnv.scene().process(currentMillis, wasModified);
-      FastLED.setBrightness(processTakeover(currentMillis));
+      if (crossfade && _nextAnimationBuilder && !_crossfading && _fadingStartTime == 0)
+      {
+        // setting up the new AnimationScene is enough work for this call
+        startCrossfade(currentMillis);
+        return;
+      }
+
+      if (_crossfading)
+      {
+        processCrossfade(currentMillis, wasModified);
+      }
+      else
+      {
+        _setupEnv.scene().process(currentMillis, wasModified);
+        FastLED.setBrightness(processTakeover(currentMillis));
+      }
+    }
+
+    void startCrossfade(uint32_t currentMillis)
+    {
+      FastLedStrip strip = _setupEnv.strip();
+      const auto ledCount = strip.ledCount();
+      if (!_crossfadeBuffers)
+      {
+        _crossfadeBuffers = new CRGB[2 * ledCount];
+        _incomingScene = new AnimationScene;
+      }
+      CRGB *leds = strip.ledArray();
+      CRGB *outgoing = &_crossfadeBuffers[0];
+      CRGB *incoming = &_crossfadeBuffers[ledCount];
+
+      PixelKernels::copy(outgoing, leds, ledCount);
+      strip.clear();
+      SetupEnv incomingEnv = _setupEnv.clone_otherScene(*_incomingScene);
+      _nextAnimationBuilder(incomingEnv);
+      _nextAnimationBuilder = nullptr;
+      // static Animations (like a VuSource) that both AnimationScenes share must run only once per frame
+      _setupEnv.scene().skipSharedAnimations(*_incomingScene);
+      PixelKernels::copy(incoming, leds, ledCount);
+      PixelKernels::copy(leds, outgoing, ledCount);
+
+      FastLED.setBrightness(maxBrightness);
+      _fadingStartTime = currentMillis;
+      _crossfadeAmount = 0;
+      _crossfading = true;
+    }
+
+    void processCrossfade(uint32_t currentMillis, bool &wasModified)
+    {
+      FastLedStrip strip = _setupEnv.strip();
+      const auto ledCount = strip.ledCount();
+      CRGB *leds = strip.ledArray();
+      CRGB *outgoing = &_crossfadeBuffers[0];
+      CRGB *incoming = &_crossfadeBuffers[ledCount];
+
+      // Both AnimationScenes draw on the same LED strip, so each one gets its own content back.
+      // AnimationScenes that are idle are skipped; their content in the buffers is still valid.
+      bool modified = false;
+      bool stripOverwritten = false;
+      if (_setupEnv.scene().getIdleMillis(currentMillis) == 0)
+      {
+        PixelKernels::copy(leds, outgoing, ledCount);
+        _setupEnv.scene().process(currentMillis, modified);
+        if (modified)
+        {
+          PixelKernels::copy(outgoing, leds, ledCount);
+        }
+        stripOverwritten = true;
+      }
+      bool incomingOnStrip = false;
+      if (_incomingScene->getIdleMillis(currentMillis) == 0)
+      {
+        bool incomingModified = false;
+        PixelKernels::copy(leds, incoming, ledCount);
+        _incomingScene->process(currentMillis, incomingModified);
+        if (incomingModified)
+        {
+          PixelKernels::copy(incoming, leds, ledCount);
+          modified = true;
+        }
+        stripOverwritten = true;
+        incomingOnStrip = true;
+      }
+
+      long amount = 255;
+      const uint32_t fadingMillis = currentMillis - _fadingStartTime;
+      if (fadingMillis < fadingDuration)
+      {
+        amount = map(fadingMillis, 0, fadingDuration, 0, 255);
+      }
+      if (amount != _crossfadeAmount)
+      {
+        _crossfadeAmount = amount;
+        modified = true;
+      }
+
+      if (!modified && !stripOverwritten)
+      {
+        // the LED strip still has the blended content of the previous call
+        return;
+      }
+      if (!incomingOnStrip)
+      {
+        PixelKernels::copy(leds, incoming, ledCount);
+      }
+
+      if (amount >= 255)
+      {
+        // the LED strip has the new AnimationScene's content
+        _setupEnv.scene().swap(*_incomingScene);
+        _incomingScene->reset();
+        _crossfading = false;
+        _fadingStartTime = 0;
+      }
+      else
+      {
+        // the LED strip has the new AnimationScene's content; blend it towards the old one
+        nblend(leds, outgoing, ledCount, 255 - amount);
+      }
+
+      if (modified)
+      {
+        wasModified = true;
+      }
     }
 
     uint8_t processTakeover(uint32_t currentMillis)
@@ -170,7 +328,7 @@ namespace EC
         {
           _fadingStartTime = currentMillis;
         }
-        linearBrightness = map(currentMillis, _fadingStartTime, _fadingStartTime + fadingDuration / 2, 255, 0);
+        linearBrightness = map(currentMillis - _fadingStartTime, 0, fadingDuration / 2, 255, 0);
         if (linearBrightness <= 0)
         {
           linearBrightness = 0;
@@ -186,7 +344,7 @@ namespace EC
         // must fade in?
         if (_fadingStartTime > 0)
         {
-          linearBrightness = map(currentMillis, _fadingStartTime, _fadingStartTime + fadingDuration / 2, 0, 255);
+          linearBrightness = map(currentMillis - _fadingStartTime, 0, fadingDuration / 2, 0, 255);
           if (linearBrightness >= 255)
           {
             linearBrightness = 255;
@@ -205,6 +363,10 @@ namespace EC
     AnimationSceneMakerFct _nextAnimationBuilder = nullptr;
     uint8_t _nextIndex;
     uint32_t _fadingStartTime = 0;
+    AnimationScene *_incomingScene = nullptr;
+    CRGB *_crossfadeBuffers = nullptr;
+    uint8_t _crossfadeAmount = 0;
+    bool _crossfading = false;
   };
 
 } // namespace EC
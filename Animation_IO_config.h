@@ -31,6 +31,8 @@
 #define LED_PIN 2
 #elif defined(ARDUINO_ARCH_ESP32) // with ESP32 boards
 #define LED_PIN 16
+#elif defined(ARDUINO_EMU) // with Arduino emulation on PC
+#define LED_PIN 6
 #else
 #error "No pin for LED data defined"
 #endif
@@ -48,6 +50,8 @@
 #define PIN_SELECT_BTN 0
 #elif defined(ARDUINO_ARCH_ESP32) // with ESP32 boards
 #define PIN_SELECT_BTN 17
+#elif defined(ARDUINO_EMU) // with Arduino emulation on PC
+#define PIN_SELECT_BTN 2
 #else
 #error "No pin for Select button defined"
 #endif
@@ -76,6 +80,8 @@
 #define PIN_MIC A0
 #elif defined(ARDUINO_ARCH_ESP32) // with ESP32 boards
 #define PIN_MIC A0
+#elif defined(ARDUINO_EMU) // with Arduino emulation on PC
+#define PIN_MIC A5
 #else
 #error "No pin for microphone defined"
 #endif
@@ -274,6 +274,12 @@ namespace EC
     {
     }
 
+    /// @see Animation::getIdleMillis()
+    uint16_t getIdleMillis(uint32_t currentMillis) override
+    {
+      return _patternUpdateTimer.getIdleMillis(currentMillis);
+    }
+
   private:
     /// @see Animation::processAnimation()
     void processAnimation(uint32_t currentMillis, bool &wasModified) override
@@ -47,6 +47,9 @@ namespace EC
     /// Flare's fading speed: Lower value = longer glowing.
     uint8_t fadeBy = 108;
 
+    /// Draw the ball's core with sub-pixel precision (anti-aliased).
+    bool antiAliased = false;
+
     /** Render the lightning ball.
      * @param strip  The LED strip.
      * @param pos  Normalized position of the ball.
@@ -72,7 +75,14 @@ namespace EC
       _shiftFlares ^= true;
 
       // draw the ball itself
-      strip.n_lineCentered(pos, size, color);
+      if (antiAliased)
+      {
+        strip.n_lineAA(pos - size / 2, pos + size / 2, color);
+      }
+      else
+      {
+        strip.n_lineCentered(pos, size, color);
+      }
     }
 
   private:
@@ -69,6 +69,9 @@ namespace EC
       colorSource.moreRed = moreRed;
     }
 
+    /// @see Animation::getIdleMillis()
+    uint16_t getIdleMillis(uint32_t currentMillis) override { return IDLE_MAX; }
+
   private:
     /// @see Animation::processAnimation()
     void processAnimation(uint32_t currentMillis, bool &wasModified) override
@@ -109,6 +112,9 @@ namespace EC
     {
     }
 
+    /// @see Animation::getIdleMillis()
+    uint16_t getIdleMillis(uint32_t currentMillis) override { return IDLE_MAX; }
+
   private:
     /// @see Animation::processAnimation()
     void processAnimation(uint32_t currentMillis, bool &wasModified) override
@@ -162,6 +168,9 @@ namespace EC
     {
     }
 
+    /// @see Animation::getIdleMillis()
+    uint16_t getIdleMillis(uint32_t currentMillis) override { return IDLE_MAX; }
+
   private:
     /// @see Animation::processAnimation()
     void processAnimation(uint32_t currentMillis, bool &wasModified) override
@@ -92,6 +92,7 @@ namespace EC
       const auto ledCount = strip.ledCount();
       const uint8_t hueOffset = beat88(64) >> 8;
 
+      auto pixels = strip.pixels().begin();
       for (uint32_t i = 0; i < ledCount; i++)
       {
         const uint32_t hueX = i * hueSqueeze * 16;
@@ -109,7 +110,7 @@ namespace EC
         vol = map(vol, 25000, 47500, 0, 255);
         vol = constrain(vol, 0, 255);
 
-        auto &pixel = strip[i];
+        auto &pixel = *(pixels++);
         pixel = CHSV(hue, 255, vol);
         if (int(pixel.r) + pixel.g + pixel.b <= 1)
         {
@@ -29,6 +29,8 @@ SOFTWARE.
 #include "Animation.h"
 #include "AnimationChanger.h"
 #include "ColorChanger.h"
+#include "FrameChangeDetector.h"
+#include "LayeredScene.h"
 #include "SetupEnv.h"
 
 // Pattern stuff
@@ -43,6 +43,7 @@ namespace EC
       fillLedBlock(0, size - 1, CRGB(64, 0, 0));
       return s_trashPixel;
     }
+    markDirty(ledIndex, ledIndex);
     return m_ledArray[ledIndex];
   }
 
@@ -54,6 +55,7 @@ namespace EC
     {
       return s_trashPixel;
     }
+    markDirty(ledIndex, ledIndex);
     return m_ledArray[ledIndex];
   }
 
@@ -91,32 +93,125 @@ namespace EC
     fillLedBlock(firstLedIndex, lastLedIndex, color);
   }
 
+  void FastLedStrip::lineAA8(int32_t firstPos, int32_t lastPos, CRGB color)
+  {
+    if (firstPos > lastPos)
+    {
+      auto temp = firstPos;
+      firstPos = lastPos;
+      lastPos = temp;
+    }
+
+    // Pixel i covers [i*256 - 128 ... i*256 + 128), and the line covers [firstPos - 128 ... lastPos + 128).
+    // Shifted by half a pixel, pixel i covers [i*256 ... i*256 + 256).
+    const int32_t begin = firstPos;
+    const int32_t end = lastPos + 256;
+    const int32_t size = getSize();
+    const int32_t firstIndex = begin >> 8;
+    const int32_t lastIndex = (end - 1) >> 8;
+    if (lastIndex < 0 || firstIndex >= size)
+    {
+      return;
+    }
+
+    if (firstIndex == lastIndex)
+    {
+      blendPixel(firstIndex, end - begin, color);
+      return;
+    }
+    if (firstIndex >= 0)
+    {
+      blendPixel(firstIndex, 256 - (begin & 0xFF), color);
+    }
+    if (lastIndex < size)
+    {
+      blendPixel(lastIndex, ((end - 1) & 0xFF) + 1, color);
+    }
+    if (lastIndex - firstIndex > 1)
+    {
+      lineAbs(firstIndex < 0 ? 0 : firstIndex + 1, lastIndex >= size ? size - 1 : lastIndex - 1, color);
+    }
+  }
+
   void FastLedStrip::shift(int16_t distance, CRGB color)
   {
-    while (distance > 0)
+    const int16_t size = getSize();
+    markDirty(0, size - 1);
+    // direction on the underlying LED array
+    const int32_t ledDistance = getReversed() ? -int32_t(distance) : distance;
+
+    if (ledDistance >= size || ledDistance <= -size)
     {
-      shiftUp(color);
-      --distance;
+      fill(color);
     }
-    while (distance < 0)
+    else if (ledDistance > 0)
     {
-      shiftDown(color);
-      ++distance;
+      // [0123456] -> [cc01234]
+      const auto d = int16_t(ledDistance);
+      memmove(&m_ledArray[d], &m_ledArray[0], (size - d) * sizeof(CRGB));
+      fillLedBlock(0, d - 1, color);
+    }
+    else if (ledDistance < 0)
+    {
+      // [0123456] -> [23456cc]
+      const auto d = int16_t(-ledDistance);
+      memmove(&m_ledArray[0], &m_ledArray[d], (size - d) * sizeof(CRGB));
+      fillLedBlock(size - d, size - 1, color);
     }
   }
 
   void FastLedStrip::rotate(int16_t distance)
   {
-    while (distance > 0)
+    const int16_t size = getSize();
+    if (size < 2)
+    {
+      return;
+    }
+
+    // upward rotation on the underlying LED array, within 0...size-1
+    int16_t d = distance % size;
+    if (getReversed())
+    {
+      d = -d;
+    }
+    if (d < 0)
+    {
+      d += size;
+    }
+    if (d == 0)
+    {
+      return;
+    }
+    markDirty(0, size - 1);
+
+    // Short distances: park the pixels that wrap around, and move the rest at once.
+    const int16_t maxParked = 8;
+    CRGB parked[maxParked];
+    if (d <= maxParked)
     {
-      rotateUp();
-      --distance;
+      // [0123456] -> [5601234]
+      memcpy(parked, &m_ledArray[size - d], d * sizeof(CRGB));
+      memmove(&m_ledArray[d], &m_ledArray[0], (size - d) * sizeof(CRGB));
+      memcpy(&m_ledArray[0], parked, d * sizeof(CRGB));
+      return;
     }
-    while (distance < 0)
+    if (size - d <= maxParked)
     {
-      rotateDown();
-      ++distance;
+      // [0123456] -> [2345601]
+      const int16_t u = size - d;
+      memcpy(parked, &m_ledArray[0], u * sizeof(CRGB));
+      memmove(&m_ledArray[0], &m_ledArray[u], (size - u) * sizeof(CRGB));
+      memcpy(&m_ledArray[size - u], parked, u * sizeof(CRGB));
+      return;
     }
+
+    // Otherwise rotating by reversal:   [0123456]
+    // reverse all:                     [6543210]
+    // reverse first d=2:               [5643210]
+    // reverse remaining:               [5601234]
+    reverseLedBlock(0, size - 1);
+    reverseLedBlock(0, d - 1);
+    reverseLedBlock(d, size - 1);
   }
 
   FastLedStrip FastLedStrip::getSubStrip(int16_t offset, int16_t newSize, bool reversed) const
@@ -152,13 +247,15 @@ namespace EC
     {
       newSize = size - offset;
     }
-    return FastLedStrip(&m_ledArray[offset], newSize, revd ^ reversed);
+    return derive(&m_ledArray[offset], newSize, revd ^ reversed);
   }
 
   void FastLedStrip::copyUp(bool mirrored)
   {
     const auto size = getSize();
     const bool revd = getReversed();
+    // one half is overwritten, depending on the direction
+    markDirty(revd ? 0 : (size + 1) / 2, revd ? size / 2 - 1 : size - 1);
 
     // copying and mirroring
     if (mirrored)
@@ -213,10 +310,7 @@ namespace EC
         CRGB *dst = &m_ledArray[(size + 1) / 2];
         CRGB *end = &m_ledArray[size];
         CRGB *src = &m_ledArray[0];
-        while (dst < end)
-        {
-          *(dst++) = *(src++);
-        }
+        PixelKernels::copy(dst, src, end - dst);
       }
       // copy upper half down
       else
@@ -230,21 +324,29 @@ namespace EC
         CRGB *dst = &m_ledArray[0];
         CRGB *end = &m_ledArray[size / 2];
         CRGB *src = &m_ledArray[(size + 1) / 2];
-        while (dst < end)
-        {
-          *(dst++) = *(src++);
-        }
+        PixelKernels::copy(dst, src, end - dst);
       }
     }
   }
 
   void FastLedStrip::fillLedBlock(int16_t firstLedIndex, int16_t lastLedIndex, CRGB color)
+  {
+    if (firstLedIndex <= lastLedIndex)
+    {
+      markDirty(firstLedIndex, lastLedIndex);
+      PixelKernels::fill(&m_ledArray[firstLedIndex], lastLedIndex - firstLedIndex + 1, color);
+    }
+  }
+
+  void FastLedStrip::reverseLedBlock(int16_t firstLedIndex, int16_t lastLedIndex)
   {
     CRGB *firstLed = &m_ledArray[firstLedIndex];
     CRGB *lastLed = &m_ledArray[lastLedIndex];
-    while (firstLed <= lastLed)
+    while (firstLed < lastLed)
     {
-      *(firstLed++) = color;
+      const CRGB temp = *firstLed;
+      *(firstLed++) = *lastLed;
+      *(lastLed--) = temp;
     }
   }
 
@@ -252,6 +354,14 @@ namespace EC
   {
     CRGB *firstLed = &m_ledArray[firstLedIndex];
     CRGB *lastLed = &m_ledArray[lastLedIndex];
+    if (firstLedIndex <= lastLedIndex)
+    {
+      markDirty(firstLedIndex, lastLedIndex);
+    }
+    else
+    {
+      markDirty(lastLedIndex, firstLedIndex);
+    }
 
     while (firstLed < lastLed)
     {
@@ -281,7 +391,7 @@ namespace EC
     strip.lineRel(startIndex, blockSize, CRGB(0, 0, color.b));
   }
 
-  void dumpPixelColorOrder(FastLedStrip strip, uint16_t blockSize = 0)
+  void dumpPixelColorOrder(FastLedStrip strip, uint16_t blockSize)
   {
     if (blockSize == 0)
     {
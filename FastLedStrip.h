@@ -27,12 +27,104 @@ SOFTWARE.
 
 #include <FastLED.h>
 #include "ColorUtils.h"
+#include "PixelKernels.h"
+
+//------------------------------------------------------------------------------
+
+#ifndef EC_TRACK_DIRTY_RANGE
+/** Let FastLedStrip record which LEDs were written, see DirtyRange.
+ * Costs a pointer per FastLedStrip and a little time per write, so it's disabled by default.
+ */
+#define EC_TRACK_DIRTY_RANGE 0
+#endif
+
+#ifndef EC_CHECK_PIXEL_ITERATORS
+/** Let every access via FastLedStrip::PixelIterator check the strip boundaries, like operator[] does.
+ * This is a debugging aid; the iterators are meant for hot loops that are bounded anyway.
+ */
+#define EC_CHECK_PIXEL_ITERATORS 0
+#endif
 
 //------------------------------------------------------------------------------
 
 namespace EC
 {
 
+  /** Fixed-point normalized position with 16 fractional bits (Q16.16), for FastLedStrip::q_pixelAA() and q_lineAA().
+   * NPOS_ONE (i.e. 1.0) corresponds to the last pixel. Like with the float based n_* methods,
+   * positions < 0 or > NPOS_ONE are allowed; they result in off-strip pixels.
+   * On 8 bit MCUs, these avoid the costly software floating point calculations.
+   */
+  using npos_t = int32_t;
+
+  /// Normalized position 1.0 as npos_t, i.e. the last pixel of the strip.
+  constexpr npos_t NPOS_ONE = 0x10000;
+
+  /// Convert the float based normalized position \a pos to npos_t.
+  inline npos_t toNpos(float pos) { return pos * NPOS_ONE; }
+
+  //------------------------------------------------------------------------------
+
+  /** Lowest and highest index of the LEDs that were written since the last reset().
+   * Attach it to the FastLedStrip that covers the whole LED array via FastLedStrip::setDirtyRange();
+   * all strips derived from that one (sub-strips, half strips, ...) report into the same range.
+   * Consumers like output stages or change detection can then skip the untouched LEDs,
+   * see e.g. TruncatedShow::show(DirtyRange &).
+   *
+   * Writing is detected conservatively: every access via FastLedStrip::pixel() or the index
+   * operator counts, as does ledArray() or iterating over the strip (for the whole strip).
+   * Only effective when EC_TRACK_DIRTY_RANGE is enabled; otherwise the range always stays empty.
+   */
+  class DirtyRange
+  {
+  public:
+    /** Constructor.
+     * @param ledArray  The LED array whose indices are recorded.
+     */
+    explicit DirtyRange(const CRGB *ledArray) : _ledArray(ledArray) {}
+
+    /// Check if nothing was written since the last reset().
+    bool isEmpty() const { return _last < _first; }
+
+    /// Lowest written LED index (only valid if not isEmpty()).
+    int16_t first() const { return _first; }
+
+    /// Highest written LED index (only valid if not isEmpty()).
+    int16_t last() const { return _last; }
+
+    /// Number of LEDs from first() to last(); 0 if nothing was written.
+    int16_t size() const { return isEmpty() ? 0 : _last - _first + 1; }
+
+    /// Forget all recorded writes, typically after the frame was shown.
+    void reset()
+    {
+      _first = 0x7FFF;
+      _last = -1;
+    }
+
+    /// Record writing the LEDs from \a firstLed to \a lastLed (both included).
+    void add(const CRGB *firstLed, const CRGB *lastLed)
+    {
+      const int16_t first = firstLed - _ledArray;
+      const int16_t last = lastLed - _ledArray;
+      if (first < _first)
+      {
+        _first = first;
+      }
+      if (last > _last)
+      {
+        _last = last;
+      }
+    }
+
+  private:
+    const CRGB *_ledArray;
+    int16_t _first = 0x7FFF;
+    int16_t _last = -1;
+  };
+
+  //------------------------------------------------------------------------------
+
   /** A thin wrapper for manipulating FastLed LED arrays.
    * Accessing the individual LED through this wrapper - e.g. pixel() or the
    * index operator [] - are always boundary-checked to prevent memory corruption.
@@ -181,6 +273,44 @@ namespace EC
       n_lineRel(centerPos - (length / 2), length, color);
     }
 
+    /** Draw an anti-aliased dot in the given \a color at the normalized position \a pos.
+     * Unlike n_pixel(), the dot is not snapped to the nearest pixel. Its intensity is split
+     * across the two neighboring pixels, blending \a color over their current content
+     * according to the covered fraction (with 8 bit precision). This gives smooth motion
+     * also at lower frame rates. Off-strip parts are ignored.
+     * @note \a pos = 0.0 corresponds to the first pixel; 1.0 corresponds to the last pixel.
+     */
+    void n_pixelAA(float pos, CRGB color)
+    {
+      q_pixelAA(toNpos(pos), color);
+    }
+
+    /** Draw an anti-aliased line in the given \a color from the normalized position \a firstPos to \a lastPos.
+     * Like n_lineAbs(), but the partially covered pixels at both ends are blended as with n_pixelAA().
+     * @note \a firstPos or \a lastPos = 0.0 corresponds to the first pixel; 1.0 corresponds to the last pixel.
+     */
+    void n_lineAA(float firstPos, float lastPos, CRGB color)
+    {
+      q_lineAA(toNpos(firstPos), toNpos(lastPos), color);
+    }
+
+    /** Draw an anti-aliased dot in the given \a color at the fixed-point normalized position \a pos.
+     * Integer counterpart of n_pixelAA().
+     */
+    void q_pixelAA(npos_t pos, CRGB color)
+    {
+      const int32_t pos8 = (pos * (getSize() - 1)) >> 8;
+      lineAA8(pos8, pos8, color);
+    }
+
+    /** Draw an anti-aliased line in the given \a color from the fixed-point normalized position \a firstPos to \a lastPos.
+     * Integer counterpart of n_lineAA().
+     */
+    void q_lineAA(npos_t firstPos, npos_t lastPos, CRGB color)
+    {
+      lineAA8((firstPos * (getSize() - 1)) >> 8, (lastPos * (getSize() - 1)) >> 8, color);
+    }
+
     /// Make the entire strip black.
     void clear()
     {
@@ -193,13 +323,14 @@ namespace EC
       fillLedBlock(0, getSize() - 1, color);
     }
 
-    /** Wrapper for FastLed's fadeToBlackBy()
+    /** Same as FastLed's fadeToBlackBy(), but using the PixelKernels.
      * Reduce the brightness of all pixels at once.
      * This function will eventually fade all the way to black.
      */
     void fadeToBlack(uint8_t fadeBy)
     {
-      fadeToBlackBy(m_ledArray, getSize(), fadeBy);
+      markDirty(0, getSize() - 1);
+      PixelKernels::scale(m_ledArray, getSize(), 255 - fadeBy);
     }
 
     /** Wrapper for FastLed's blur1d()
@@ -214,6 +345,7 @@ namespace EC
      */
     void blur(uint8_t blurAmount, uint8_t blurCycles = 1)
     {
+      markDirty(0, getSize() - 1);
       while (blurCycles--)
       {
         blur1d(m_ledArray, getSize(), blurAmount);
@@ -229,25 +361,27 @@ namespace EC
     /** Shift the LED strip for the given \a distance, setting the inserted pixels to \a color.
      * Posive values of \a distance shift upward (from begin to end), negative values shift
      * downward (from end to begin).
+     * The strip is moved at once, so the runtime does not depend on \a distance.
      */
     void shift(int16_t distance, CRGB color = CRGB::Black);
 
     /// Rotate the LED strip from begin to end (set the first pixel to last pixel's old content).
-    void rotateUp() { shiftUp(pixel(getLastLedIndex())); }
+    void rotateUp() { shiftUp(m_ledArray[getLastLedIndex()]); }
 
     /// Rotate the LED strip from end to begin (set the last pixel to first pixel's old content).
-    void rotateDown() { shiftDown(pixel(getFirstLedIndex())); }
+    void rotateDown() { shiftDown(m_ledArray[getFirstLedIndex()]); }
 
     /** Rotate the LED strip for the given \a distance.
      * Posive values of \a distance rotate upward (from begin to end), negative values rotate
      * downward (from end to begin).
+     * The strip is rotated in a single block move (or three reversals for large distances).
      */
     void rotate(int16_t distance);
 
     /// Get a new strip with the same underlying LED pixel array, but reversed drawing direction.
     FastLedStrip getReversedStrip() const
     {
-      return FastLedStrip(m_ledArray, getSize(), getReversed() ^ true);
+      return derive(m_ledArray, getSize(), getReversed() ^ true);
     }
 
     /** Get a new strip consisting of the first half of the underlying LED pixel array.
@@ -270,7 +404,7 @@ namespace EC
         //   new strip: [012]         [0123]
         //   new index: |0>2|         |0->3|     reversed = false
         //   new index: |2<0|         |3<-0|     reversed = true
-        return FastLedStrip(&m_ledArray[0], (size + 1) / 2, revd ^ reversed);
+        return derive(&m_ledArray[0], (size + 1) / 2, revd ^ reversed);
       }
       // current strip is reversed
       else
@@ -282,7 +416,7 @@ namespace EC
         //   new strip:    [012]         [0123]
         //   new index:    |2<0|         |3<-0|     reversed = false
         //   new index:    |0>2|         |0->3|     reversed = true
-        return FastLedStrip(&m_ledArray[size / 2], (size + 1) / 2, revd ^ reversed);
+        return derive(&m_ledArray[size / 2], (size + 1) / 2, revd ^ reversed);
       }
     }
 
@@ -298,6 +432,16 @@ namespace EC
      */
     FastLedStrip getSubStrip(int16_t offset, int16_t newSize, bool reversed = false) const;
 
+    /** Get a new strip with the same size and drawing direction, but on the separate LED pixel array \a buffer.
+     * Useful for rendering into an off-screen buffer that is later combined with this strip.
+     * The new strip does not report into this strip's DirtyRange.
+     * @param buffer  Must provide at least ledCount() pixels.
+     */
+    FastLedStrip getBufferStrip(CRGB *buffer) const
+    {
+      return FastLedStrip(buffer, getSize(), getReversed());
+    }
+
     /** Copy (and optionally mirror) the lower half of this strip into its upper half.
      * Any existing content in the upper half is overwritten.
      * @param mirrored  \c false = straight copying, \c true = mirror the content
@@ -312,14 +456,134 @@ namespace EC
      * Use this method only when calling FastLed functions directly; mostly together with ledCount().
      * @note The strip's "reversed" property has no effect when this method is used!
      */
-    CRGB *ledArray() { return m_ledArray; }
+    CRGB *ledArray()
+    {
+      markDirty(0, getSize() - 1);
+      return m_ledArray;
+    }
 
     // Enable iterating over all pixels of the strip via range-based for loop.
     // Use that only when the strip's direction (i.e. the "reversed" property) is not relevant.
     using iterator = CRGB *;
-    iterator begin() { return &m_ledArray[0]; }
+    iterator begin()
+    {
+      markDirty(0, getSize() - 1);
+      return &m_ledArray[0];
+    }
     iterator end() { return &m_ledArray[getSize()]; }
 
+    /** Iterator over the pixels of a FastLedStrip, which respects the strip's direction.
+     * Unlike operator[], there is no bounds check and no reversed-index conversion per pixel,
+     * so it is meant for loops that are bounded by the strip anyway.
+     * When EC_CHECK_PIXEL_ITERATORS is enabled, every access is checked like with operator[].
+     * @see pixels()
+     */
+    class PixelIterator
+    {
+    public:
+      /// Access the current pixel.
+      CRGB &operator*() const { return at(_ledIndex); }
+      CRGB *operator->() const { return &at(_ledIndex); }
+
+      /// Access the pixel that is  offset steps ahead of the current one.
+      CRGB &operator[](int16_t offset) const { return at(_ledIndex + offset * _step); }
+
+      PixelIterator &operator++()
+      {
+        _ledIndex += _step;
+        return *this;
+      }
+
+      PixelIterator operator++(int)
+      {
+        PixelIterator result = *this;
+        _ledIndex += _step;
+        return result;
+      }
+
+      bool operator==(const PixelIterator &other) const { return _ledIndex == other._ledIndex; }
+      bool operator!=(const PixelIterator &other) const { return _ledIndex != other._ledIndex; }
+
+    private:
+      friend class FastLedStrip;
+
+      PixelIterator(CRGB *ledArray, int16_t ledIndex, int8_t step, int16_t size)
+          : _ledArray(ledArray), _ledIndex(ledIndex), _step(step)
+      {
+#if (EC_CHECK_PIXEL_ITERATORS)
+        _size = size;
+#else
+        (void)size;
+#endif
+      }
+
+      CRGB &at(int16_t ledIndex) const
+      {
+#if (EC_CHECK_PIXEL_ITERATORS)
+        if (ledIndex < 0 || ledIndex >= _size)
+        {
+          PixelKernels::fill(_ledArray, _size, CRGB(64, 0, 0));
+          return s_trashPixel;
+        }
+#endif
+        return _ledArray[ledIndex];
+      }
+
+      CRGB *_ledArray;
+      int16_t _ledIndex;
+      int8_t _step;
+#if (EC_CHECK_PIXEL_ITERATORS)
+      int16_t _size;
+#endif
+    };
+
+    /// A range of pixels for range-based for loops; see pixels() and reversedPixels().
+    class PixelRange
+    {
+    public:
+      PixelIterator begin() const { return _begin; }
+      PixelIterator end() const { return _end; }
+
+    private:
+      friend class FastLedStrip;
+      PixelRange(PixelIterator begin, PixelIterator end) : _begin(begin), _end(end) {}
+      PixelIterator _begin;
+      PixelIterator _end;
+    };
+
+    /** All pixels of the strip in drawing direction, i.e. from index 0 to ledCount() - 1.
+     * Intended for hot loops that write every pixel, like
+     * <tt>for (auto &pixel : strip.pixels()) pixel = color;</tt> \n
+     * The whole strip is considered as modified.
+     */
+    PixelRange pixels()
+    {
+      const auto size = getSize();
+      markDirty(0, size - 1);
+      return getReversed() ? makeRange(size - 1, -1, -1) : makeRange(0, size, 1);
+    }
+
+    /// All pixels of the strip in the opposite of the drawing direction, i.e. from ledCount() - 1 to index 0.
+    PixelRange reversedPixels()
+    {
+      const auto size = getSize();
+      markDirty(0, size - 1);
+      return getReversed() ? makeRange(0, size, 1) : makeRange(size - 1, -1, -1);
+    }
+
+    /** Record all writes to this strip (and all strips derived from it) in \a dirtyRange.
+     * Only effective when EC_TRACK_DIRTY_RANGE is enabled.
+     * @param dirtyRange  Must refer to the underlying LED array; \c nullptr = no recording.
+     */
+    void setDirtyRange(DirtyRange *dirtyRange)
+    {
+#if (EC_TRACK_DIRTY_RANGE)
+      m_dirtyRange = dirtyRange;
+#else
+      (void)dirtyRange;
+#endif
+    }
+
     /** Get null object.
      * @see https://en.wikipedia.org/wiki/Null_object_pattern
      */
@@ -328,6 +592,37 @@ namespace EC
   private:
     FastLedStrip() : m_ledArray(&s_trashPixel), m_sizeNrev(0) {}
 
+    /// Another strip on the same LED array, which reports into the same DirtyRange.
+    FastLedStrip derive(CRGB *ledArray, int16_t ledCount, bool reversed) const
+    {
+      FastLedStrip strip(ledArray, ledCount, reversed);
+#if (EC_TRACK_DIRTY_RANGE)
+      strip.m_dirtyRange = m_dirtyRange;
+#endif
+      return strip;
+    }
+
+    /// Record writing the LEDs from \a firstLedIndex to \a lastLedIndex (both included).
+    void markDirty(int16_t firstLedIndex, int16_t lastLedIndex)
+    {
+#if (EC_TRACK_DIRTY_RANGE)
+      if (m_dirtyRange && firstLedIndex <= lastLedIndex)
+      {
+        m_dirtyRange->add(&m_ledArray[firstLedIndex], &m_ledArray[lastLedIndex]);
+      }
+#else
+      (void)firstLedIndex;
+      (void)lastLedIndex;
+#endif
+    }
+
+    PixelRange makeRange(int16_t firstLedIndex, int16_t endLedIndex, int8_t step) const
+    {
+      const auto size = getSize();
+      return PixelRange(PixelIterator(m_ledArray, firstLedIndex, step, size),
+                        PixelIterator(m_ledArray, endLedIndex, step, size));
+    }
+
     int16_t getSize() const { return m_sizeNrev & 0x7FFF; }
 
     bool getReversed() const { return m_sizeNrev & 0x8000; }
@@ -344,6 +639,20 @@ namespace EC
 
     void fillLedBlock(int16_t firstLedIndex, int16_t lastLedIndex, CRGB color);
 
+    /** Draw an anti-aliased line from \a firstPos to \a lastPos.
+     * Both positions are pixel indices with 8 fractional bits, i.e. 256 is the center of pixel 1.
+     */
+    void lineAA8(int32_t firstPos, int32_t lastPos, CRGB color);
+
+    /// Blend \a color over the pixel at \a index, which is covered by \a coverage / 256.
+    void blendPixel(int32_t index, uint16_t coverage, CRGB color)
+    {
+      nblend(pixel(int16_t(index)), color, coverage > 255 ? 255 : coverage);
+    }
+
+    /// Reverse the order of the LED pixels from \a firstLedIndex to \a lastLedIndex.
+    void reverseLedBlock(int16_t firstLedIndex, int16_t lastLedIndex);
+
     /** Shift all LED pixels by one from \a firstLedIndex to \a lastLedIndex.
      * After this operation, the old content of the LED at \a lastLedIndex will be gone,
      * and the content of the LED at \a firstLedIndex will be \a newColor.
@@ -354,6 +663,9 @@ namespace EC
     static CRGB s_trashPixel;
     CRGB *m_ledArray;
     uint16_t m_sizeNrev;
+#if (EC_TRACK_DIRTY_RANGE)
+    DirtyRange *m_dirtyRange = nullptr;
+#endif
   };
 
   //------------------------------------------------------------------------------
@@ -102,7 +102,7 @@ namespace EC
     static const uint16_t FRAMES_PER_SECOND = 60;
 
     // Array of temperature readings at each simulation cell
-    byte heat[NUM_LEDS];
+    byte heat[NUM_LEDS] = {};
     uint8_t hue = 0;
 
   public:
@@ -184,6 +184,7 @@ namespace EC
       }
 
       // Step 4.  Map from heat cells to LED colors
+      auto pixel = strip.pixels().begin();
       for (int j = 0; j < ledCount; j++)
       {
         // Scale the heat value from 0-255 down to 0-240
@@ -203,7 +204,7 @@ namespace EC
         }
         leds[pixelnumber] = color;
 #else
-        strip[j] = color;
+        *(pixel++) = color;
 #endif
       }
     }
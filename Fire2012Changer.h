@@ -50,6 +50,9 @@ namespace EC
     {
     }
 
+    /// @see Animation::getIdleMillis()
+    uint16_t getIdleMillis(uint32_t currentMillis) override { return IDLE_MAX; }
+
   private:
     /// @see Animation::processAnimation()
     void processAnimation(uint32_t currentMillis, bool &wasModified) override
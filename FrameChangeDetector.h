@@ -0,0 +1,123 @@
+#pragma once
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+#include <FastLED.h>
+#include "FastLedStrip.h"
+
+//------------------------------------------------------------------------------
+
+namespace EC
+{
+
+  /** Detects whether the content of a LED strip has actually changed since the last frame.
+   * Many Animations report a modification even when they rendered the very same frame again,
+   * e.g. static backgrounds, or slow Patterns that are processed at the full refresh rate.
+   * Skipping FastLED.show() for such frames saves the whole transmission time, during which
+   * the interrupts are blocked (which e.g. makes the ADC sampling in VU mode more regular).
+   *
+   * The detection uses a cheap checksum over all LEDs and FastLED's brightness, so unlike a
+   * shadow copy of the strip it needs only a few bytes of RAM, regardless of the strip's size.
+   * In the very rare case of a checksum collision, a changed frame is not shown until the next
+   * change.
+   *
+   * The checksum costs a pass over the whole LED strip for every frame, so this only pays off
+   * for sketches whose Animations often render the same frame again. Example:
+   * @code
+   * if (animationScene.process() && frameChange.hasChanged())
+   * {
+   *   FastLED.show();
+   * }
+   * @endcode
+   * @note Temporal dithering of FastLED only happens while frames are being shown.
+   */
+  class FrameChangeDetector
+  {
+  public:
+    /** Constructor.
+     * @param ledArray  The LED array to observe.
+     * @param ledCount  Number of LEDs.
+     */
+    FrameChangeDetector(const CRGB *ledArray, uint16_t ledCount)
+        : _ledArray(ledArray), _ledCount(ledCount)
+    {
+    }
+
+    /** Constructor.
+     * @param strip  Observe the whole LED array of this strip.
+     */
+    explicit FrameChangeDetector(FastLedStrip strip)
+        : FrameChangeDetector(strip.ledArray(), strip.ledCount())
+    {
+    }
+
+    /** Check if the LEDs or FastLED's brightness changed since the last call.
+     * @retval true   The frame has changed and should be shown.
+     * @retval false  The frame is the same as the last one, so FastLED.show() can be skipped.
+     */
+    bool hasChanged()
+    {
+      const uint32_t checksum = calcChecksum(_ledArray, _ledCount, FastLED.getBrightness());
+      if (checksum == _checksum && !_invalid)
+      {
+        return false;
+      }
+      _checksum = checksum;
+      _invalid = false;
+      return true;
+    }
+
+    /// Let the next hasChanged() call return true in any case.
+    void invalidate() { _invalid = true; }
+
+    /** Fletcher-like checksum over all color channels of the given LEDs.
+     * Both sums are only 16 bit wide, which keeps it cheap on 8 bit MCUs.
+     * Also sensitive to the order of the bytes, so moving pixels changes the checksum.
+     */
+    static uint32_t calcChecksum(const CRGB *ledArray, uint16_t ledCount, uint8_t seed = 0)
+    {
+      const uint8_t *data = &ledArray[0].raw[0];
+      const uint8_t *const end = data + 3 * ledCount;
+      uint16_t sum1 = seed;
+      uint16_t sum2 = 0;
+      while (data != end)
+      {
+        sum1 += *data++;
+        sum2 += sum1;
+      }
+      return (uint32_t(sum2) << 16) | sum1;
+    }
+
+  private:
+    const CRGB *_ledArray;
+    uint16_t _ledCount;
+    uint32_t _checksum = 0;
+    bool _invalid = true;
+  };
+
+} // namespace EC
+
+//------------------------------------------------------------------------------
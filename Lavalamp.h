@@ -55,6 +55,12 @@ namespace EC
     /// Color source of the Animation.
     ColorWheel color;
 
+    /** Draw the blobs with sub-pixel precision (anti-aliased) instead of snapping to whole pixels.
+     * Gives smooth motion also at lower frame rates.
+     * This setting can be adjusted at runtime.
+     */
+    bool antiAliased = false;
+
     /** Constructor.
      * @param ledStrip  The LED strip.
      * @param colorBPM  How fast the color changes.
@@ -87,7 +93,14 @@ namespace EC
         theBlob.process(_ceiling, _floor, i);
         if (theBlob.isActive())
         {
-          strip.n_lineAbs(theBlob.posMin(), theBlob.posMax(), color);
+          if (antiAliased)
+          {
+            strip.n_lineAA(theBlob.posMin(), theBlob.posMax(), color);
+          }
+          else
+          {
+            strip.n_lineAbs(theBlob.posMin(), theBlob.posMax(), color);
+          }
         }
       }
 
@@ -373,7 +386,7 @@ namespace EC
       State _state = ready;
       float _pos = 0.0;
       float _radius = 0.0;
-      static const float _transferFactor = 0.67;
+      static constexpr float _transferFactor = 0.67;
     };
 
   private:
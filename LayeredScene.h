@@ -0,0 +1,292 @@
+#pragma once
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+#include "Animation.h"
+#include "FastLedStrip.h"
+#include "PixelKernels.h"
+
+//------------------------------------------------------------------------------
+
+namespace EC
+{
+
+  /// How a layer of a LayeredScene is combined with the layers below it.
+  enum class BlendMode : uint8_t
+  {
+    /// The layer covers everything below.
+    Replace,
+    /// Colors are added (saturating at 255); black is transparent.
+    Add,
+    /// The brighter value of every color channel wins; black is transparent.
+    Max,
+    /// The layer is blended over the layers below according to its opacity.
+    Alpha,
+  };
+
+  //------------------------------------------------------------------------------
+
+  /** Compositor for Animations that render into separate layers.
+   * In an AnimationScene, all Animations draw directly on the same LED strip, so a Pattern must
+   * be redrawn whenever an Overlay wants to update, and vice versa. Here, each layer has its own
+   * LED buffer and AnimationScene. Every layer is processed at its own update period, and only
+   * the layers that changed are rendered again; the others are reused as they are. The final
+   * frame is composited from all layers (bottom to top) whenever any of them changed.
+   *
+   * Example:
+   * @code
+   * auto &layers = env.add(new EC::LayeredScene(env.strip()));
+   * auto &ocean = layers.addLayer();
+   * ocean.add(new EC::Pacifica(ocean.strip()));
+   * auto &bubbles = layers.addLayer(EC::BlendMode::Max);
+   * bubbles.add(new EC::Bubbles(bubbles.strip(), false));
+   * @endcode
+   *
+   * A LayeredScene renders the entire LED strip, so it's used like a Pattern.
+   * @note Each layer costs 3 bytes of RAM per LED for its buffer, which is allocated on the heap.
+   */
+  class LayeredScene
+      : public Animation
+  {
+  public:
+    /// A layer of a LayeredScene; see LayeredScene::addLayer()
+    class Layer
+    {
+    public:
+      /// How this layer is combined with the layers below it.
+      BlendMode blendMode;
+
+      /// Opacity for BlendMode::Alpha; 255 = opaque, 0 = invisible.
+      uint8_t opacity = 255;
+
+      /// The LED strip of this layer, for constructing the layer's Animations.
+      FastLedStrip strip() const { return _strip; }
+
+      /** Add the given (allocated) \a animation to this layer's AnimationScene.
+       * @return Reference to the given \a animation (so the caller can apply further settings)
+       * @note \a animation must be allocated on the heap, and draw on this layer's strip().
+       */
+      template <class AnimationType>
+      AnimationType &add(AnimationType *animation)
+      {
+        return *_scene.append(animation);
+      }
+
+      /** Add the given (static) \a animation to this layer's AnimationScene.
+       * @return The given \a animation (so the caller can apply further settings)
+       * @note \a animation must have static lifetime, and draw on this layer's strip().
+       */
+      template <class AnimationType>
+      AnimationType &add(AnimationType &animation)
+      {
+        return *_scene.append(animation);
+      }
+
+      /** Set the pause (in ms) between processing the Animations of this layer.
+       * 0 (the default) means that they are processed on every call, i.e. that their own
+       * update rates apply.
+       */
+      void setUpdatePeriod(uint16_t period) { _updateTimer.updatePeriod = period; }
+
+      /// Get the pause (in ms) between processing the Animations of this layer.
+      uint16_t getUpdatePeriod() const { return _updateTimer.updatePeriod; }
+
+    private:
+      friend class LayeredScene;
+
+      Layer(FastLedStrip ledStrip, BlendMode blendMode, uint16_t updatePeriod)
+          : blendMode(blendMode), _strip(ledStrip), _updateTimer(updatePeriod)
+      {
+      }
+
+      ~Layer() { delete[] _strip.ledArray(); }
+
+      /// Time (in ms) until the layer's Animations must be processed again.
+      uint16_t getIdleMillis(uint32_t currentMillis)
+      {
+        if (_updateTimer.updatePeriod)
+        {
+          return _updateTimer.getIdleMillis(currentMillis);
+        }
+        return _scene.getIdleMillis(currentMillis);
+      }
+
+      /// Process the layer's Animations; returns \c true when the layer's content changed.
+      bool process(uint32_t currentMillis)
+      {
+        if (_updateTimer.updatePeriod && !_updateTimer.process(currentMillis))
+        {
+          return false;
+        }
+        bool wasModified = false;
+        _scene.process(currentMillis, wasModified);
+        return wasModified;
+      }
+
+      /// Combine this layer with the \a count LEDs in \a output.
+      void blendInto(CRGB *output, uint16_t count)
+      {
+        const CRGB *leds = _strip.ledArray();
+        switch (blendMode)
+        {
+        case BlendMode::Replace:
+          PixelKernels::copy(output, leds, count);
+          break;
+        case BlendMode::Add:
+          PixelKernels::add(output, leds, count);
+          break;
+        case BlendMode::Max:
+          PixelKernels::maxChannels(output, leds, count);
+          break;
+        case BlendMode::Alpha:
+          for (uint16_t i = 0; i < count; ++i)
+          {
+            nblend(output[i], leds[i], opacity);
+          }
+          break;
+        }
+      }
+
+      Layer *_nextLayer = nullptr;
+      FastLedStrip _strip;
+      AnimationScene _scene;
+      AnimationTimer _updateTimer;
+    };
+
+    /** Constructor.
+     * @param ledStrip  The LED strip where the layers are composited.
+     */
+    explicit LayeredScene(FastLedStrip ledStrip)
+        : _strip(ledStrip)
+    {
+    }
+
+    /// Destructor. Also destroys all layers and their Animations.
+    ~LayeredScene()
+    {
+      reset();
+    }
+
+    /** Add a new layer on top of all existing ones.
+     * @param blendMode  How the new layer is combined with the layers below it.
+     * @param updatePeriod  Pause (in ms) between processing the layer's Animations;
+     *                      0 = on every call, i.e. their own update rates apply.
+     * @return The new layer, for adding its Animations.
+     */
+    Layer &addLayer(BlendMode blendMode = BlendMode::Replace, uint16_t updatePeriod = 0)
+    {
+      const auto ledCount = _strip.ledCount();
+      CRGB *leds = new CRGB[ledCount];
+      PixelKernels::fill(leds, ledCount, CRGB::Black);
+      Layer *layer = new Layer(_strip.getBufferStrip(leds), blendMode, updatePeriod);
+
+      Layer **tailPtr = &_layerListHead;
+      while (*tailPtr)
+      {
+        tailPtr = &(*tailPtr)->_nextLayer;
+      }
+      *tailPtr = layer;
+      invalidate();
+      return *layer;
+    }
+
+    /** Remove (and delete) all layers and their Animations.
+     * This LayeredScene is empty afterwards, and can be filled again with new layers.
+     */
+    void reset()
+    {
+      while (_layerListHead)
+      {
+        Layer *toDelete = _layerListHead;
+        _layerListHead = _layerListHead->_nextLayer;
+        delete toDelete;
+      }
+    }
+
+    /** Composite the layers again with the next process() call, even when none of them changed.
+     * Call this after changing a layer's blend mode or opacity.
+     */
+    void invalidate() { _invalid = true; }
+
+    /// @see Animation::getIdleMillis()
+    uint16_t getIdleMillis(uint32_t currentMillis) override
+    {
+      uint16_t idleMillis = _invalid ? 0 : IDLE_MAX;
+      for (Layer *layer = _layerListHead; layer; layer = layer->_nextLayer)
+      {
+        const uint16_t layerIdleMillis = layer->getIdleMillis(currentMillis);
+        if (layerIdleMillis < idleMillis)
+        {
+          idleMillis = layerIdleMillis;
+        }
+      }
+      return idleMillis;
+    }
+
+  private:
+    /// @see Animation::processAnimation()
+    void processAnimation(uint32_t currentMillis, bool &wasModified) override
+    {
+      bool changed = _invalid;
+      for (Layer *layer = _layerListHead; layer; layer = layer->_nextLayer)
+      {
+        if (layer->process(currentMillis))
+        {
+          changed = true;
+        }
+      }
+
+      if (changed)
+      {
+        composite();
+        _invalid = false;
+        wasModified = true;
+      }
+    }
+
+    void composite()
+    {
+      const auto ledCount = _strip.ledCount();
+      CRGB *output = _strip.ledArray();
+      if (!_layerListHead || _layerListHead->blendMode != BlendMode::Replace)
+      {
+        PixelKernels::fill(output, ledCount, CRGB::Black);
+      }
+      for (Layer *layer = _layerListHead; layer; layer = layer->_nextLayer)
+      {
+        layer->blendInto(output, ledCount);
+      }
+    }
+
+  private:
+    FastLedStrip _strip;
+    Layer *_layerListHead = nullptr;
+    bool _invalid = true;
+  };
+
+} // namespace EC
+
+//------------------------------------------------------------------------------
@@ -30,6 +30,17 @@ SOFTWARE.
 
 //------------------------------------------------------------------------------
 
+/** Count float multiplications and divisions, to estimate their cost on AVR.
+ * Only with the Arduino emulation on PC; see FastLED.getOpCount().
+ */
+#if defined(ARDUINO_EMU)
+#define EC_COUNT_FLOAT_OPS(mul, div) (emuCountOp(EmuOp_FloatMul, mul), emuCountOp(EmuOp_FloatDiv, div))
+#else
+#define EC_COUNT_FLOAT_OPS(mul, div) ((void)0)
+#endif
+
+//------------------------------------------------------------------------------
+
 namespace EC
 {
 
@@ -39,6 +50,7 @@ namespace EC
   inline float randomF(float max = 1.0)
   {
     const int32_t prec = 0x08000000; // respect float's 23 bit precision
+    EC_COUNT_FLOAT_OPS(1, 1);
     return (float(random(prec)) * max) / prec;
   }
 
@@ -63,6 +75,7 @@ namespace EC
    */
   inline float beatF(float bpm, float lowest = 0.0, float highest = 1.0, uint32_t timebase = 0)
   {
+    EC_COUNT_FLOAT_OPS(2, 1);
     float x = beat88(bpm * 256, timebase);
     x /= 0xFFFF;
     x *= (highest - lowest);
@@ -80,6 +93,7 @@ namespace EC
    */
   inline float beatsinF(float bpm, float lowest, float highest, uint32_t timebase = 0, float phaseOffset = 0.0)
   {
+    EC_COUNT_FLOAT_OPS(3, 1);
     float x = beatsin88(bpm * 256, 0, 0xFFFF, timebase, phaseOffset * 0xFFFF);
     x /= 0xFFFF;
     x *= (highest - lowest);
@@ -126,6 +140,7 @@ namespace EC
      */
     float process(float newValue)
     {
+      EC_COUNT_FLOAT_OPS(1, 1);
       avgValue *= avgLength;
       avgValue += newValue;
       avgValue /= avgLength + 1;
@@ -69,6 +69,12 @@ namespace EC
      */
     float size = 0.05;
 
+    /** Draw with sub-pixel precision (anti-aliased) instead of snapping to whole pixels.
+     * Gives smooth motion also at lower frame rates.
+     * This setting can be adjusted at runtime.
+     */
+    bool antiAliased = false;
+
     /** Constructor.
      * @param ledStrip  The LED strip.
      * @param overlayMode  Set to \c true when the Animation shall be an Overlay.
@@ -102,7 +108,11 @@ namespace EC
       const float pos = beatsinF(bpm, 0.0 - overshoot, 1.0 + overshoot, 0, phaseOffset);
       const float colorJitter = inoise8(currentMillis) / 384.0;
       const CRGB col = color[colorJitter];
-      if (size > 0.0)
+      if (antiAliased)
+      {
+        strip.n_lineAA(pos - size / 2, pos + size / 2, col);
+      }
+      else if (size > 0.0)
       {
         strip.n_lineCentered(pos, size, col);
       }
@@ -0,0 +1,396 @@
+#pragma once
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+#include <FastLED.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+
+/// Implementations of the PixelKernels, selectable via EC_PIXEL_KERNELS.
+#define EC_PIXEL_KERNELS_SCALAR 0
+#define EC_PIXEL_KERNELS_SWAR 1
+#define EC_PIXEL_KERNELS_SSE2 2
+#define EC_PIXEL_KERNELS_NEON 3
+
+#ifndef EC_PIXEL_KERNELS
+/** Implementation of the PixelKernels.
+ * By default, the best one for the target is chosen: SSE2 or NEON when available, SWAR
+ * (i.e. 4 bytes at once in a 32 bit register) for other 32 bit MCUs like the ESP32, and
+ * the plain FastLED functions for 8 bit MCUs like the AVR.
+ */
+#if defined(__SSE2__)
+#define EC_PIXEL_KERNELS EC_PIXEL_KERNELS_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define EC_PIXEL_KERNELS EC_PIXEL_KERNELS_NEON
+#elif defined(ARDUINO_ARCH_AVR) || (__SIZEOF_POINTER__ < 4)
+#define EC_PIXEL_KERNELS EC_PIXEL_KERNELS_SCALAR
+#else
+#define EC_PIXEL_KERNELS EC_PIXEL_KERNELS_SWAR
+#endif
+#endif
+
+#if (EC_PIXEL_KERNELS == EC_PIXEL_KERNELS_SSE2)
+#include <emmintrin.h>
+#elif (EC_PIXEL_KERNELS == EC_PIXEL_KERNELS_NEON)
+#include <arm_neon.h>
+#endif
+
+//------------------------------------------------------------------------------
+
+namespace EC
+{
+
+  /** Bulk operations on LED arrays, used by FastLedStrip for its whole-strip operations.
+   * They process several bytes at once where the target supports it. Since CRGB has 3 bytes,
+   * operations that treat all color channels the same (like scale() or add()) simply run over
+   * the raw bytes; fill() works with a repeating pattern of 4 (SWAR) or 16 (SSE2, NEON) pixels.
+   * All implementations give exactly the same results as FastLED's per-pixel functions.
+   */
+  namespace PixelKernels
+  {
+    /// Set \a count LEDs to \a color.
+    inline void fill(CRGB *leds, uint16_t count, CRGB color);
+
+    /// Scale \a count LEDs down by \a scale / 256; same as FastLED's nscale8().
+    inline void scale(CRGB *leds, uint16_t count, uint8_t scale);
+
+    /// Add \a count LEDs of \a src to \a dst, saturating at 255; same as CRGB::operator+=().
+    inline void add(CRGB *dst, const CRGB *src, uint16_t count);
+
+    /// Set every color channel of \a count LEDs of \a dst to the maximum of \a dst and \a src.
+    inline void maxChannels(CRGB *dst, const CRGB *src, uint16_t count);
+
+    /// Copy \a count LEDs from \a src to \a dst; the ranges may overlap.
+    inline void copy(CRGB *dst, const CRGB *src, uint16_t count)
+    {
+      memmove(dst, src, count * sizeof(CRGB));
+    }
+
+    //------------------------------------------------------------------------------
+
+    /// Scalar fallbacks; also used for the bytes that don't fill a whole register.
+    namespace Scalar
+    {
+      inline void fill(CRGB *leds, uint16_t count, CRGB color)
+      {
+        CRGB *const end = leds + count;
+        while (leds < end)
+        {
+          *(leds++) = color;
+        }
+      }
+
+      inline void scale(uint8_t *data, uint32_t bytes, uint8_t scale)
+      {
+        uint8_t *const end = data + bytes;
+        while (data < end)
+        {
+          *data = scale8(*data, scale);
+          ++data;
+        }
+      }
+
+      inline void add(uint8_t *dst, const uint8_t *src, uint32_t bytes)
+      {
+        uint8_t *const end = dst + bytes;
+        while (dst < end)
+        {
+          *dst = qadd8(*dst, *(src++));
+          ++dst;
+        }
+      }
+
+      inline void maxChannels(uint8_t *dst, const uint8_t *src, uint32_t bytes)
+      {
+        uint8_t *const end = dst + bytes;
+        for (; dst < end; ++dst, ++src)
+        {
+          if (*src > *dst)
+          {
+            *dst = *src;
+          }
+        }
+      }
+    } // namespace Scalar
+
+    //------------------------------------------------------------------------------
+
+#if (EC_PIXEL_KERNELS == EC_PIXEL_KERNELS_SCALAR)
+
+    inline void fill(CRGB *leds, uint16_t count, CRGB color)
+    {
+      Scalar::fill(leds, count, color);
+    }
+
+    inline void scale(CRGB *leds, uint16_t count, uint8_t scale)
+    {
+      nscale8(leds, count, scale);
+    }
+
+    inline void add(CRGB *dst, const CRGB *src, uint16_t count)
+    {
+      Scalar::add(reinterpret_cast<uint8_t *>(dst), reinterpret_cast<const uint8_t *>(src), 3 * uint32_t(count));
+    }
+
+    inline void maxChannels(CRGB *dst, const CRGB *src, uint16_t count)
+    {
+      Scalar::maxChannels(reinterpret_cast<uint8_t *>(dst), reinterpret_cast<const uint8_t *>(src), 3 * uint32_t(count));
+    }
+
+#elif (EC_PIXEL_KERNELS == EC_PIXEL_KERNELS_SWAR)
+
+    namespace Swar
+    {
+      inline uint32_t load(const uint8_t *data)
+      {
+        uint32_t word;
+        memcpy(&word, data, sizeof(word));
+        return word;
+      }
+
+      inline void store(uint8_t *data, uint32_t word)
+      {
+        memcpy(data, &word, sizeof(word));
+      }
+
+      /// Scale all 4 bytes of \a word like scale8().
+      inline uint32_t scale(uint32_t word, uint16_t factor)
+      {
+        // every byte gets 16 bit of headroom, so the products don't overlap
+        const uint32_t even = (((word & 0x00FF00FF) * factor) >> 8) & 0x00FF00FF;
+        const uint32_t odd = (((word >> 8) & 0x00FF00FF) * factor) & 0xFF00FF00;
+        return even | odd;
+      }
+
+      /// Add all 4 bytes of \a a and \a b like qadd8().
+      inline uint32_t add(uint32_t a, uint32_t b)
+      {
+        const uint32_t low7 = (a & 0x7F7F7F7F) + (b & 0x7F7F7F7F);
+        const uint32_t carry = ((a & b) | ((a | b) & low7)) & 0x80808080;
+        const uint32_t sum = low7 ^ ((a ^ b) & 0x80808080);
+        return sum | ((carry >> 7) * 0xFF);
+      }
+    } // namespace Swar
+
+    inline void fill(CRGB *leds, uint16_t count, CRGB color)
+    {
+      if (count < 8)
+      {
+        Scalar::fill(leds, count, color);
+        return;
+      }
+      // the first 4 pixels are the pattern for all others
+      Scalar::fill(leds, 4, color);
+      uint8_t *data = reinterpret_cast<uint8_t *>(leds);
+      const uint32_t pattern[3] = {Swar::load(data), Swar::load(data + 4), Swar::load(data + 8)};
+      uint8_t *const end = data + 3 * (count & ~3);
+      data += 12;
+      while (data < end)
+      {
+        Swar::store(data, pattern[0]);
+        Swar::store(data + 4, pattern[1]);
+        Swar::store(data + 8, pattern[2]);
+        data += 12;
+      }
+      Scalar::fill(&leds[count & ~3], count & 3, color);
+    }
+
+    inline void scale(CRGB *leds, uint16_t count, uint8_t scale)
+    {
+      const uint16_t factor = uint16_t(scale) + 1;
+      uint8_t *data = reinterpret_cast<uint8_t *>(leds);
+      const uint32_t bytes = 3 * uint32_t(count);
+      uint8_t *const end = data + (bytes & ~3);
+      for (; data < end; data += 4)
+      {
+        Swar::store(data, Swar::scale(Swar::load(data), factor));
+      }
+      Scalar::scale(data, bytes & 3, scale);
+    }
+
+    inline void add(CRGB *dst, const CRGB *src, uint16_t count)
+    {
+      uint8_t *d = reinterpret_cast<uint8_t *>(dst);
+      const uint8_t *s = reinterpret_cast<const uint8_t *>(src);
+      const uint32_t bytes = 3 * uint32_t(count);
+      uint8_t *const end = d + (bytes & ~3);
+      for (; d < end; d += 4, s += 4)
+      {
+        Swar::store(d, Swar::add(Swar::load(d), Swar::load(s)));
+      }
+      Scalar::add(d, s, bytes & 3);
+    }
+
+    inline void maxChannels(CRGB *dst, const CRGB *src, uint16_t count)
+    {
+      // a byte-wise compare costs more in SWAR than it saves
+      Scalar::maxChannels(reinterpret_cast<uint8_t *>(dst), reinterpret_cast<const uint8_t *>(src), 3 * uint32_t(count));
+    }
+
+#elif (EC_PIXEL_KERNELS == EC_PIXEL_KERNELS_SSE2)
+
+    inline void fill(CRGB *leds, uint16_t count, CRGB color)
+    {
+      if (count < 32)
+      {
+        Scalar::fill(leds, count, color);
+        return;
+      }
+      // the first 16 pixels are the pattern for all others
+      Scalar::fill(leds, 16, color);
+      uint8_t *data = reinterpret_cast<uint8_t *>(leds);
+      const __m128i p0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+      const __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16));
+      const __m128i p2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 32));
+      uint8_t *const end = data + 3 * (count & ~15);
+      data += 48;
+      for (; data < end; data += 48)
+      {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(data), p0);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(data + 16), p1);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(data + 32), p2);
+      }
+      Scalar::fill(&leds[count & ~15], count & 15, color);
+    }
+
+    inline void scale(CRGB *leds, uint16_t count, uint8_t scale)
+    {
+      const __m128i zero = _mm_setzero_si128();
+      const __m128i factor = _mm_set1_epi16(int16_t(scale) + 1);
+      uint8_t *data = reinterpret_cast<uint8_t *>(leds);
+      const uint32_t bytes = 3 * uint32_t(count);
+      uint8_t *const end = data + (bytes & ~15);
+      for (; data < end; data += 16)
+      {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+        // (v * 256 * factor) >> 16 = (v * factor) >> 8
+        const __m128i lo = _mm_mulhi_epu16(_mm_unpacklo_epi8(zero, v), factor);
+        const __m128i hi = _mm_mulhi_epu16(_mm_unpackhi_epi8(zero, v), factor);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(data), _mm_packus_epi16(lo, hi));
+      }
+      Scalar::scale(data, bytes & 15, scale);
+    }
+
+    inline void add(CRGB *dst, const CRGB *src, uint16_t count)
+    {
+      uint8_t *d = reinterpret_cast<uint8_t *>(dst);
+      const uint8_t *s = reinterpret_cast<const uint8_t *>(src);
+      const uint32_t bytes = 3 * uint32_t(count);
+      uint8_t *const end = d + (bytes & ~15);
+      for (; d < end; d += 16, s += 16)
+      {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(d));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(d), _mm_adds_epu8(a, b));
+      }
+      Scalar::add(d, s, bytes & 15);
+    }
+
+    inline void maxChannels(CRGB *dst, const CRGB *src, uint16_t count)
+    {
+      uint8_t *d = reinterpret_cast<uint8_t *>(dst);
+      const uint8_t *s = reinterpret_cast<const uint8_t *>(src);
+      const uint32_t bytes = 3 * uint32_t(count);
+      uint8_t *const end = d + (bytes & ~15);
+      for (; d < end; d += 16, s += 16)
+      {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(d));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(d), _mm_max_epu8(a, b));
+      }
+      Scalar::maxChannels(d, s, bytes & 15);
+    }
+
+#elif (EC_PIXEL_KERNELS == EC_PIXEL_KERNELS_NEON)
+
+    inline void fill(CRGB *leds, uint16_t count, CRGB color)
+    {
+      uint8x16x3_t pattern;
+      pattern.val[0] = vdupq_n_u8(color.raw[0]);
+      pattern.val[1] = vdupq_n_u8(color.raw[1]);
+      pattern.val[2] = vdupq_n_u8(color.raw[2]);
+      uint8_t *data = reinterpret_cast<uint8_t *>(leds);
+      uint8_t *const end = data + 3 * (count & ~15);
+      for (; data < end; data += 48)
+      {
+        vst3q_u8(data, pattern);
+      }
+      Scalar::fill(&leds[count & ~15], count & 15, color);
+    }
+
+    inline void scale(CRGB *leds, uint16_t count, uint8_t scale)
+    {
+      const uint8x8_t factor = vdup_n_u8(scale);
+      uint8_t *data = reinterpret_cast<uint8_t *>(leds);
+      const uint32_t bytes = 3 * uint32_t(count);
+      uint8_t *const end = data + (bytes & ~15);
+      for (; data < end; data += 16)
+      {
+        const uint8x16_t v = vld1q_u8(data);
+        // v * (scale + 1) = v * scale + v
+        const uint16x8_t lo = vaddw_u8(vmull_u8(vget_low_u8(v), factor), vget_low_u8(v));
+        const uint16x8_t hi = vaddw_u8(vmull_u8(vget_high_u8(v), factor), vget_high_u8(v));
+        vst1q_u8(data, vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8)));
+      }
+      Scalar::scale(data, bytes & 15, scale);
+    }
+
+    inline void add(CRGB *dst, const CRGB *src, uint16_t count)
+    {
+      uint8_t *d = reinterpret_cast<uint8_t *>(dst);
+      const uint8_t *s = reinterpret_cast<const uint8_t *>(src);
+      const uint32_t bytes = 3 * uint32_t(count);
+      uint8_t *const end = d + (bytes & ~15);
+      for (; d < end; d += 16, s += 16)
+      {
+        vst1q_u8(d, vqaddq_u8(vld1q_u8(d), vld1q_u8(s)));
+      }
+      Scalar::add(d, s, bytes & 15);
+    }
+
+    inline void maxChannels(CRGB *dst, const CRGB *src, uint16_t count)
+    {
+      uint8_t *d = reinterpret_cast<uint8_t *>(dst);
+      const uint8_t *s = reinterpret_cast<const uint8_t *>(src);
+      const uint32_t bytes = 3 * uint32_t(count);
+      uint8_t *const end = d + (bytes & ~15);
+      for (; d < end; d += 16, s += 16)
+      {
+        vst1q_u8(d, vmaxq_u8(vld1q_u8(d), vld1q_u8(s)));
+      }
+      Scalar::maxChannels(d, s, bytes & 15);
+    }
+
+#else
+#error "Unknown EC_PIXEL_KERNELS implementation"
+#endif
+
+  } // namespace PixelKernels
+
+} // namespace EC
+
+//------------------------------------------------------------------------------
@@ -80,6 +80,7 @@ namespace EC
       sHue16 += deltams * beatsin88(400, 5, 9);
       uint16_t brightnesstheta16 = sPseudotime;
 
+      auto pixel = strip.reversedPixels().begin();
       for (uint16_t i = 0; i < strip.ledCount(); i++)
       {
         hue16 += hueinc16;
@@ -98,10 +99,7 @@ namespace EC
 
         CRGB newcolor = CHSV(hue8, sat8, bri8);
 
-        uint16_t pixelnumber = i;
-        pixelnumber = (strip.ledCount() - 1) - pixelnumber;
-
-        nblend(strip[pixelnumber], newcolor, 64);
+        nblend(*(pixel++), newcolor, 64);
       }
     }
   };
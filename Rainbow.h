@@ -81,6 +81,7 @@ namespace EC
     /// @see AnimationBase::showPattern()
     void showPattern(uint32_t currentMillis) override
     {
+      auto pixel = strip.pixels().begin();
       for (auto i = 0; i < strip.ledCount(); i++)
       {
         uint8_t pixelHue = _hue + i * deltahue;
@@ -88,7 +89,7 @@ namespace EC
         {
           pixelHue = redShift(pixelHue);
         }
-        strip[i] = CHSV(pixelHue, 255, volume);
+        *(pixel++) = CHSV(pixelHue, 255, volume);
       }
     }
 
@@ -151,6 +151,18 @@ namespace EC
       return retval;
     }
 
+    /** Clone this SetupEnv but for setting up the given AnimationScene.
+     * @param scene  Operate on that AnimationScene instead.
+     */
+    SetupEnv clone_otherScene(AnimationScene &scene) const
+    {
+      SetupEnv retval(_strip, scene, _makeVuSource);
+#ifdef EC_SETUP_ENV_USER_DATA_TYPE
+      retval.userData = userData;
+#endif
+      return retval;
+    }
+
 #ifdef EC_SETUP_ENV_USER_DATA_TYPE
     using UserDataType = EC_SETUP_ENV_USER_DATA_TYPE;
     UserDataType *userData = nullptr;
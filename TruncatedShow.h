@@ -0,0 +1,140 @@
+#pragma once
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+#include <FastLED.h>
+#include "FastLedStrip.h"
+
+//------------------------------------------------------------------------------
+
+namespace EC
+{
+
+  /** Replacement for FastLED.show() that transmits only the LEDs up to the last changed one.
+   * WS2812-like strips must always be clocked from the first LED, but all LEDs behind the
+   * last transmitted one simply keep their color. Since the transmission takes about 30 µs
+   * per LED, this can raise the achievable frame rate considerably on long strips, e.g. when
+   * only the lower part of the strip is animated.
+   *
+   * The changes are detected by comparing against a shadow copy of the last transmitted frame,
+   * so this costs 3 bytes of RAM per LED.
+   * The whole strip is transmitted when FastLED's brightness changed, and after invalidate().
+   * @note Temporal dithering of FastLED only affects the transmitted LEDs; consider disabling
+   * it via FastLED.setDither(0).
+   * @tparam MAX_LEDS  Maximum number of LEDs of the strip.
+   */
+  template <uint16_t MAX_LEDS>
+  class TruncatedShow
+  {
+  public:
+    /** Constructor.
+     * @param controller  The LED strip, as returned by FastLED.addLeds(); at most \a MAX_LEDS long.
+     */
+    explicit TruncatedShow(CLEDController &controller)
+        : _controller(controller)
+    {
+    }
+
+    /** Show the LED strip, transmitting only the LEDs up to the last changed one.
+     * Nothing is transmitted when no LED changed.
+     * @return Number of transmitted LEDs.
+     */
+    uint16_t show()
+    {
+      return transmit(_controller.size());
+    }
+
+#if (EC_TRACK_DIRTY_RANGE)
+    /** Same as show(), but only the LEDs up to the last written one (according to \a dirtyRange)
+     * are compared with the last transmitted frame; the LEDs behind it can't have changed.
+     * \a dirtyRange must record all writes since the last show(), i.e. it must be attached to
+     * the FastLedStrip of the whole LED array; it's reset afterwards for the next frame.
+     * @return Number of transmitted LEDs.
+     */
+    uint16_t show(DirtyRange &dirtyRange)
+    {
+      const uint16_t writtenCount = dirtyRange.isEmpty() ? 0 : dirtyRange.last() + 1;
+      dirtyRange.reset();
+      return transmit(writtenCount);
+    }
+#endif
+
+    /// Transmit the whole LED strip with the next show(), e.g. after FastLED.clear(true).
+    void invalidate() { _invalid = true; }
+
+  private:
+    /// Transmit up to the last LED that changed; only the first \a searchCount LEDs can have changed.
+    uint16_t transmit(uint16_t searchCount)
+    {
+      CRGB *leds = _controller.leds();
+      const int size = _controller.size();
+      if (size > MAX_LEDS)
+      {
+        // strip is too long for the shadow copy
+        FastLED.show();
+        return size;
+      }
+
+      if (FastLED.getBrightness() != _brightness)
+      {
+        _brightness = FastLED.getBrightness();
+        _invalid = true;
+      }
+
+      uint16_t count = size;
+      if (!_invalid)
+      {
+        if (searchCount < count)
+        {
+          count = searchCount;
+        }
+        while (count > 0 && leds[count - 1] == _shadow[count - 1])
+        {
+          --count;
+        }
+        if (count == 0)
+        {
+          return 0;
+        }
+      }
+      _invalid = false;
+
+      memcpy(_shadow, leds, count * sizeof(CRGB));
+      _controller.setLeds(leds, count);
+      FastLED.show();
+      _controller.setLeds(leds, size);
+      return count;
+    }
+
+    CLEDController &_controller;
+    CRGB _shadow[MAX_LEDS];
+    uint8_t _brightness = 0;
+    bool _invalid = true;
+  };
+
+} // namespace EC
+
+//------------------------------------------------------------------------------
@@ -54,6 +54,12 @@ namespace EC
      */
     float size;
 
+    /** Draw with sub-pixel precision (anti-aliased) instead of snapping to whole pixels.
+     * Gives smooth motion also at lower frame rates.
+     * This setting can be adjusted at runtime.
+     */
+    bool antiAliased = false;
+
     /** Constructor.
      * @param ledStrip  The LED strip.
      * @param vuSource  Input for calculating the VU Overlay.
@@ -80,6 +86,16 @@ namespace EC
       if (!wasModified)
         return;
 
+      if (antiAliased)
+      {
+        const float vuLevel = _vuSource.getVU();
+        if (vuLevel > 0.0)
+        {
+          _strip.n_lineAA(vuLevel - size, vuLevel, color);
+        }
+        return;
+      }
+
       const float vuLevel = _vuSource.getVU();
       if (vuLevel > 0.0)
       {
@@ -53,6 +53,12 @@ namespace EC
      */
     float size;
 
+    /** Draw with sub-pixel precision (anti-aliased) instead of snapping to whole pixels.
+     * Gives smooth motion also at lower frame rates.
+     * This setting can be adjusted at runtime.
+     */
+    bool antiAliased = false;
+
     /** Constructor.
      * @param ledStrip  The LED strip.
      * @param vuSource  Input for calculating the VU level and color.
@@ -98,6 +104,17 @@ namespace EC
         return;
 
       color.update();
+      if (antiAliased)
+      {
+        const float vuLevel = _vuLevelSource.getVU();
+        const float colorVuLevel = _vuCcolorSource.getVU();
+        if (vuLevel > 0.0)
+        {
+          _strip.n_lineAA(vuLevel - size, vuLevel, color[colorVuLevel]);
+        }
+        return;
+      }
+
       const float vuLevel = _vuLevelSource.getVU();
       const float colorVuLevel = _vuCcolorSource.getVU();
 
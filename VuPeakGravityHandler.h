@@ -87,7 +87,7 @@ namespace EC
     }
 
     /// Activate peak detection.
-    bool arm()
+    void arm()
     {
       _isArmed = true;
     }
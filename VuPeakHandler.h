@@ -121,7 +121,7 @@ namespace EC
         _lastPeakTime = currentMillis;
       }
       // peak hold?
-      else if (currentMillis <= _lastPeakTime + peakHold)
+      else if (currentMillis - _lastPeakTime <= peakHold)
       {
         // nothing to do
       }
@@ -48,7 +48,7 @@ namespace EC
     /** Get null object.
      * @see https://en.wikipedia.org/wiki/Null_object_pattern
      */
-    static VuSource &VuSource::getNull();
+    static VuSource &getNull();
 
   protected:
     VuSource() = default;
@@ -51,6 +51,9 @@ SOFTWARE.
 CRGB leds[NUM_LEDS];
 EC::FastLedStrip mainStrip(leds, NUM_LEDS);
 
+// for skipping FastLED.show() when the frame did not change
+EC::FrameChangeDetector frameChange(mainStrip);
+
 // Rainbow in the lower third
 EC::FastLedStrip rainbowStrip = mainStrip.getSubStrip(0, NUM_LEDS / 3);
 
@@ -99,7 +102,7 @@ void loop()
     updateColor();
     updateSpeed();
 
-    if (animationScene.process())
+    if (animationScene.process() && frameChange.hasChanged())
     {
         FastLED.show();
     }
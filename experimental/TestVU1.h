@@ -81,6 +81,9 @@ namespace EC
       vuDipGravityHandler.enableDipMode = true;
     }
 
+    /// @see Animation::getIdleMillis()
+    uint16_t getIdleMillis(uint32_t currentMillis) override { return 0; }
+
   private:
     /// @see Animation::processAnimation()
     void processAnimation(uint32_t currentMillis, bool &wasModified) override
@@ -91,6 +91,9 @@ namespace EC
     {
     }
 
+    /// @see Animation::getIdleMillis()
+    uint16_t getIdleMillis(uint32_t currentMillis) override { return 0; }
+
   private:
     /// @see Animation::processAnimation()
     void processAnimation(uint32_t currentMillis, bool &wasModified) override
@@ -214,6 +217,9 @@ namespace EC
       vuPeakHandlerRms_log.peakDecay = vuPeakHandlerAvg.peakDecay;
     }
 
+    /// @see Animation::getIdleMillis()
+    uint16_t getIdleMillis(uint32_t currentMillis) override { return 0; }
+
   private:
     /// @see Animation::processAnimation()
     void processAnimation(uint32_t currentMillis, bool &wasModified) override
@@ -25,19 +25,238 @@ SOFTWARE.
 
 *******************************************************************************/
 
-#ifndef _MSC_VER
-#error "This file should not have been included!"
+/* Emulation of the Arduino core API for building EyeCandy on a PC.
+ * Covers the subset that is used by the library and its example sketches.
+ * It is modeled after the AVR core, so that integer behavior (like random())
+ * matches an Arduino Uno / Nano as close as possible.
+ */
+
+// Like the ARDUINO_ARCH_* macros, these are usually provided by the build system.
+#ifndef ARDUINO
+#define ARDUINO 10819
+#endif
+#ifndef ARDUINO_EMU
+#define ARDUINO_EMU 1
 #endif
 
 //------------------------------------------------------------------------------
 
+#include <math.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <type_traits>
+
+using std::abs;
+
+//------------------------------------------------------------------------------
+
+typedef bool boolean;
+typedef uint8_t byte;
+typedef uint16_t word;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define DEFAULT 1
+#define EXTERNAL 0
+#define INTERNAL 3
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define PI 3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define NUM_DIGITAL_PINS 20
+#define NUM_ANALOG_INPUTS 6
+#define LED_BUILTIN 13
+
+static const uint8_t A0 = 14;
+static const uint8_t A1 = 15;
+static const uint8_t A2 = 16;
+static const uint8_t A3 = 17;
+static const uint8_t A4 = 18;
+static const uint8_t A5 = 19;
+
+//------------------------------------------------------------------------------
+
+// Like the AVR core, but as templates to avoid clashes with the C++ library.
+template <typename T, typename L>
+inline auto min(T a, L b) -> typename std::decay<decltype(b < a ? b : a)>::type
+{
+	return (b < a) ? b : a;
+}
+
+template <typename T, typename L>
+inline auto max(T a, L b) -> typename std::decay<decltype(b < a ? b : a)>::type
+{
+	return (a < b) ? b : a;
+}
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define radians(deg) ((deg) * DEG_TO_RAD)
+#define degrees(rad) ((rad) * RAD_TO_DEG)
+#define sq(x) ((x) * (x))
+
+#define lowByte(w) ((uint8_t)((w) & 0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(b) (1UL << (b))
+
+/// Provided by avr-libc's math.h
+inline double square(double x) { return x * x; }
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+//------------------------------------------------------------------------------
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_float(addr) (*(const float *)(addr))
+#define pgm_read_ptr(addr) (*(void *const *)(addr))
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+//------------------------------------------------------------------------------
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+//------------------------------------------------------------------------------
+
+/// Same algorithm as avr-libc, so random sequences match an AVR board.
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+//------------------------------------------------------------------------------
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogReference(uint8_t mode);
+void analogWrite(uint8_t pin, int val);
+
+//------------------------------------------------------------------------------
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+/// Simplified version of Arduino's Print class.
+class Print
+{
+public:
+	virtual ~Print() = default;
+
+	virtual size_t write(uint8_t c) = 0;
+	virtual size_t write(const uint8_t *buffer, size_t size);
+	size_t write(const char *str) { return str ? write(reinterpret_cast<const uint8_t *>(str), strlen(str)) : 0; }
+
+	size_t print(const __FlashStringHelper *str) { return write(reinterpret_cast<const char *>(str)); }
+	size_t print(const char str[]) { return write(str); }
+	size_t print(char c) { return write(uint8_t(c)); }
+	size_t print(unsigned char n, int base = DEC) { return print((unsigned long)n, base); }
+	size_t print(int n, int base = DEC) { return print((long)n, base); }
+	size_t print(unsigned int n, int base = DEC) { return print((unsigned long)n, base); }
+	size_t print(long n, int base = DEC);
+	size_t print(unsigned long n, int base = DEC);
+	size_t print(double n, int digits = 2);
+
+	size_t println() { return write("\r\n"); }
+	template <typename T>
+	size_t println(const T &value) { return print(value) + println(); }
+	template <typename T>
+	size_t println(const T &value, int format) { return print(value, format) + println(); }
+
+	virtual void flush() {}
+
+private:
+	size_t printNumber(unsigned long n, uint8_t base);
+};
+
+/// Serial port that writes to stdout (and never receives any data).
+class HardwareSerial : public Print
+{
+public:
+	void begin(unsigned long baud) { (void)baud; }
+	void end() {}
+	int available() { return 0; }
+	int peek() { return -1; }
+	int read() { return -1; }
+	void flush() override;
+	size_t write(uint8_t c) override;
+	size_t write(const uint8_t *buffer, size_t size) override;
+	using Print::write;
+	operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+//------------------------------------------------------------------------------
+
+/// Hooks for controlling the emulated hardware.
+namespace ArduinoEmu
+{
+	/// Level that analogRead() returns for the given \a pin (default: 512).
+	void setAnalogInput(uint8_t pin, uint16_t value);
+
+	/// Level that digitalRead() returns for the given input \a pin.
+	/// Pins configured as INPUT_PULLUP read HIGH unless set otherwise.
+	void setDigitalInput(uint8_t pin, bool level);
+
+	/// Level that was written to the given output \a pin.
+	bool getDigitalOutput(uint8_t pin);
+
+	/** Let millis() and micros() follow a simulated clock instead of the real time.
+	 * The simulated clock only advances via advanceSimulatedClock() and delay().
+	 * This allows rendering Animations much faster than in real time.
+	 * @param startMicros  Initial value of the simulated clock.
+	 */
+	void enableSimulatedClock(uint64_t startMicros = 0);
+
+	/// Let millis() and micros() follow the real time again.
+	void disableSimulatedClock();
+
+	/// Check if the simulated clock is active.
+	bool isSimulatedClock();
+
+	/// Advance the simulated clock by \a us microseconds.
+	void advanceSimulatedClock(uint32_t us);
+
+	/// Current time of the simulated clock (in microseconds, without overflow).
+	uint64_t getSimulatedMicros();
+
+} // namespace ArduinoEmu
 
 //------------------------------------------------------------------------------
 
-void delay(uint32_t ms);
-int32_t random(int32_t max);
-int32_t random(int32_t min, int32_t max);
-void randomSeed(uint32_t seed);
+// Implemented by the sketch.
+void setup();
+void loop();
 
 //------------------------------------------------------------------------------
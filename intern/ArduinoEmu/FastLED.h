@@ -25,43 +25,1236 @@ SOFTWARE.
 
 *******************************************************************************/
 
-#ifndef _MSC_VER
-#error "This file should not have been included!"
-#endif
+/* Emulation of the FastLED library for building EyeCandy on a PC.
+ * Covers the subset that is used by the library and its example sketches.
+ * The math functions are portable C ports of FastLED's lib8tion, hsv2rgb,
+ * colorutils and noise implementations (with FASTLED_SCALE8_FIXED), so that
+ * the rendered pixels match those on a real board as close as possible.
+ */
 
+#include "Arduino.h"
+
+#define FASTLED_VERSION 3006000
+#define FASTLED_SCALE8_FIXED 1
+
+//------------------------------------------------------------------------------
+// operation counters (emulation only)
 //------------------------------------------------------------------------------
 
-#include "Arduino.h"
+/** Operations that are expensive on an AVR, and therefore counted by the emulation.
+ * This allows estimating the cost of an Animation on a microcontroller from a
+ * host run; see FastLED.getOpCount(). Not available with the real FastLED.
+ */
+enum EEmuOp
+{
+	EmuOp_HSV2RGB,			///< CHSV to CRGB conversions
+	EmuOp_inoise8,			///< inoise8() and inoise8_raw()
+	EmuOp_inoise16,			///< inoise16() and inoise16_raw()
+	EmuOp_ColorFromPalette, ///< ColorFromPalette()
+	EmuOp_random8,			///< random8()
+	EmuOp_random16,			///< random16()
+	EmuOp_blur1d,			///< blur1d() calls
+	EmuOp_FloatMul,			///< float multiplications (only those counted by EyeCandy's MathUtils)
+	EmuOp_FloatDiv,			///< float divisions (only those counted by EyeCandy's MathUtils)
+	EmuOp_COUNT
+};
+
+extern uint32_t emuOpCounts[EmuOp_COUNT];
+
+/// Count \a n occurrences of the given operation.
+inline void emuCountOp(EEmuOp op, uint32_t n = 1) { emuOpCounts[op] += n; }
+
+/// Name of the given operation, for reports.
+const char *emuOpName(EEmuOp op);
+
+//------------------------------------------------------------------------------
+// lib8tion
+//------------------------------------------------------------------------------
+
+typedef uint8_t fract8;
+typedef uint16_t fract16;
+typedef int8_t sfract7;
+typedef int16_t sfract15;
+typedef uint16_t accum88;
+typedef int16_t saccum78;
+typedef int16_t saccum87;
+typedef uint32_t accum1616;
+typedef int32_t saccum1516;
+typedef uint16_t accum124;
+typedef int32_t saccum114;
+
+inline uint8_t qadd8(uint8_t i, uint8_t j)
+{
+	const unsigned int t = i + j;
+	return (t > 255) ? 255 : uint8_t(t);
+}
+
+inline int8_t qadd7(int8_t i, int8_t j)
+{
+	const int t = i + j;
+	return (t > 127) ? 127 : (t < -128) ? -128 : int8_t(t);
+}
+
+inline uint8_t qsub8(uint8_t i, uint8_t j)
+{
+	const int t = i - j;
+	return (t < 0) ? 0 : uint8_t(t);
+}
+
+inline uint8_t qmul8(uint8_t i, uint8_t j)
+{
+	const unsigned int p = unsigned(i) * j;
+	return (p > 255) ? 255 : uint8_t(p);
+}
+
+inline uint8_t add8(uint8_t i, uint8_t j) { return uint8_t(i + j); }
+inline uint8_t sub8(uint8_t i, uint8_t j) { return uint8_t(i - j); }
+inline uint8_t mul8(uint8_t i, uint8_t j) { return uint8_t(i * j); }
+inline uint8_t avg8(uint8_t i, uint8_t j) { return uint8_t((i + j) >> 1); }
+inline uint16_t avg16(uint16_t i, uint16_t j) { return uint16_t((uint32_t(i) + j) >> 1); }
+inline int8_t avg7(int8_t i, int8_t j) { return int8_t((i >> 1) + (j >> 1) + (i & 0x1)); }
+inline int16_t avg15(int16_t i, int16_t j) { return int16_t((i >> 1) + (j >> 1) + (i & 0x1)); }
+inline uint8_t abs8(int8_t i) { return uint8_t((i < 0) ? -i : i); }
+inline uint8_t mod8(uint8_t a, uint8_t m) { return a % m; }
+inline uint8_t addmod8(uint8_t a, uint8_t b, uint8_t m) { return uint8_t(a + b) % m; }
+inline uint8_t submod8(uint8_t a, uint8_t b, uint8_t m) { return uint8_t(a - b) % m; }
+
+inline uint8_t scale8(uint8_t i, fract8 scale)
+{
+	return uint8_t((uint16_t(i) * (1 + uint16_t(scale))) >> 8);
+}
+
+inline uint8_t scale8_video(uint8_t i, fract8 scale)
+{
+	return uint8_t(((int(i) * int(scale)) >> 8) + ((i && scale) ? 1 : 0));
+}
+
+inline uint8_t scale8_LEAVING_R1_DIRTY(uint8_t i, fract8 scale) { return scale8(i, scale); }
+inline uint8_t scale8_video_LEAVING_R1_DIRTY(uint8_t i, fract8 scale) { return scale8_video(i, scale); }
+inline void cleanup_R1() {}
+
+inline void nscale8x3(uint8_t &r, uint8_t &g, uint8_t &b, fract8 scale)
+{
+	r = scale8(r, scale);
+	g = scale8(g, scale);
+	b = scale8(b, scale);
+}
+
+inline void nscale8x3_video(uint8_t &r, uint8_t &g, uint8_t &b, fract8 scale)
+{
+	r = scale8_video(r, scale);
+	g = scale8_video(g, scale);
+	b = scale8_video(b, scale);
+}
+
+inline uint16_t scale16by8(uint16_t i, fract8 scale)
+{
+	return uint16_t((uint32_t(i) * (1 + uint32_t(scale))) >> 8);
+}
+
+inline uint16_t scale16(uint16_t i, fract16 scale)
+{
+	return uint16_t((uint32_t(i) * (1 + uint32_t(scale))) >> 16);
+}
+
+inline uint8_t dim8_raw(uint8_t x) { return scale8(x, x); }
+inline uint8_t dim8_video(uint8_t x) { return scale8_video(x, x); }
+inline uint8_t dim8_lin(uint8_t x) { return (x & 0x80) ? scale8(x, x) : uint8_t(((x + 1) * (x + 1) >> 8) + (x ? 1 : 0)); }
+inline uint8_t brighten8_raw(uint8_t x) { return uint8_t(255 - scale8(255 - x, 255 - x)); }
+inline uint8_t brighten8_video(uint8_t x) { return uint8_t(255 - scale8_video(255 - x, 255 - x)); }
+
+uint16_t sqrt16(uint16_t x);
+
+inline uint8_t lerp8by8(uint8_t a, uint8_t b, fract8 frac)
+{
+	return (b > a) ? uint8_t(a + scale8(b - a, frac)) : uint8_t(a - scale8(a - b, frac));
+}
+
+inline uint16_t lerp16by16(uint16_t a, uint16_t b, fract16 frac)
+{
+	return (b > a) ? uint16_t(a + scale16(b - a, frac)) : uint16_t(a - scale16(a - b, frac));
+}
+
+inline uint16_t lerp16by8(uint16_t a, uint16_t b, fract8 frac)
+{
+	return (b > a) ? uint16_t(a + scale16by8(b - a, frac)) : uint16_t(a - scale16by8(a - b, frac));
+}
+
+inline int16_t lerp15by8(int16_t a, int16_t b, fract8 frac)
+{
+	return (b > a) ? int16_t(a + scale16by8(uint16_t(b - a), frac)) : int16_t(a - scale16by8(uint16_t(a - b), frac));
+}
+
+inline int16_t lerp15by16(int16_t a, int16_t b, fract16 frac)
+{
+	return (b > a) ? int16_t(a + scale16(uint16_t(b - a), frac)) : int16_t(a - scale16(uint16_t(a - b), frac));
+}
+
+inline uint8_t map8(uint8_t in, uint8_t rangeStart, uint8_t rangeEnd)
+{
+	return uint8_t(rangeStart + scale8(in, rangeEnd - rangeStart));
+}
+
+inline uint8_t blend8(uint8_t a, uint8_t b, uint8_t amountOfB)
+{
+	uint16_t partial = uint16_t((a << 8) | b);
+	partial = uint16_t(partial + b * amountOfB);
+	partial = uint16_t(partial - a * amountOfB);
+	return uint8_t(partial >> 8);
+}
+
+inline fract8 ease8InOutQuad(fract8 i)
+{
+	uint8_t j = (i & 0x80) ? uint8_t(255 - i) : i;
+	uint8_t jj2 = uint8_t(scale8(j, j) << 1);
+	return (i & 0x80) ? uint8_t(255 - jj2) : jj2;
+}
+
+inline fract16 ease16InOutQuad(fract16 i)
+{
+	uint16_t j = (i & 0x8000) ? uint16_t(65535 - i) : i;
+	uint16_t jj2 = uint16_t(scale16(j, j) << 1);
+	return (i & 0x8000) ? uint16_t(65535 - jj2) : jj2;
+}
+
+inline fract8 ease8InOutCubic(fract8 i)
+{
+	const uint8_t ii = scale8(i, i);
+	const uint8_t iii = scale8(ii, i);
+	const uint16_t r1 = uint16_t(3 * uint16_t(ii) - 2 * uint16_t(iii));
+	return (r1 & 0x100) ? 255 : uint8_t(r1);
+}
+
+inline fract8 ease8InOutApprox(fract8 i)
+{
+	if (i < 64)
+	{
+		return uint8_t(i / 2);
+	}
+	if (i > (255 - 64))
+	{
+		return uint8_t(255 - (255 - i) / 2);
+	}
+	return uint8_t(32 + ((i - 64) * 3) / 2);
+}
+
+inline uint8_t triwave8(uint8_t in)
+{
+	if (in & 0x80)
+	{
+		in = uint8_t(255 - in);
+	}
+	return uint8_t(in << 1);
+}
+
+inline uint8_t quadwave8(uint8_t in) { return ease8InOutQuad(triwave8(in)); }
+inline uint8_t cubicwave8(uint8_t in) { return ease8InOutCubic(triwave8(in)); }
+
+uint8_t sin8(uint8_t theta);
+inline uint8_t cos8(uint8_t theta) { return sin8(uint8_t(theta + 64)); }
+
+int16_t sin16(uint16_t theta);
+inline int16_t cos16(uint16_t theta) { return sin16(uint16_t(theta + 16384)); }
+
+//------------------------------------------------------------------------------
+
+extern uint16_t rand16seed;
+
+// Uncounted building blocks of random8() and random16()
+inline uint16_t emuRandom16()
+{
+	rand16seed = uint16_t(rand16seed * 2053 + 13849);
+	return rand16seed;
+}
+inline uint8_t emuRandom8()
+{
+	emuRandom16();
+	return uint8_t(uint8_t(rand16seed & 0xFF) + uint8_t(rand16seed >> 8));
+}
+inline uint8_t emuRandom8(uint8_t lim) { return uint8_t((emuRandom8() * lim) >> 8); }
+inline uint16_t emuRandom16(uint16_t lim) { return uint16_t((uint32_t(lim) * emuRandom16()) >> 16); }
+
+inline uint16_t random16()
+{
+	emuCountOp(EmuOp_random16);
+	return emuRandom16();
+}
+
+inline uint8_t random8()
+{
+	emuCountOp(EmuOp_random8);
+	return emuRandom8();
+}
+
+inline uint8_t random8(uint8_t lim)
+{
+	emuCountOp(EmuOp_random8);
+	return emuRandom8(lim);
+}
+inline uint8_t random8(uint8_t min, uint8_t lim)
+{
+	emuCountOp(EmuOp_random8);
+	return uint8_t(emuRandom8(uint8_t(lim - min)) + min);
+}
+inline uint16_t random16(uint16_t lim)
+{
+	emuCountOp(EmuOp_random16);
+	return emuRandom16(lim);
+}
+inline uint16_t random16(uint16_t min, uint16_t lim)
+{
+	emuCountOp(EmuOp_random16);
+	return uint16_t(emuRandom16(uint16_t(lim - min)) + min);
+}
+
+inline void random16_set_seed(uint16_t seed) { rand16seed = seed; }
+inline uint16_t random16_get_seed() { return rand16seed; }
+inline void random16_add_entropy(uint16_t entropy) { rand16seed = uint16_t(rand16seed + entropy); }
 
 //------------------------------------------------------------------------------
 
-// hide content of original headerfile
-#define __INC_LIB8TION_TRIG_H
+#define GET_MILLIS() uint32_t(millis())
+
+inline uint16_t beat88(accum88 beats_per_minute_88, uint32_t timebase = 0)
+{
+	return uint16_t(((GET_MILLIS() - timebase) * beats_per_minute_88 * 280) >> 16);
+}
+
+inline uint16_t beat16(accum88 beats_per_minute, uint32_t timebase = 0)
+{
+	if (beats_per_minute < 256)
+	{
+		beats_per_minute <<= 8;
+	}
+	return beat88(beats_per_minute, timebase);
+}
+
+inline uint8_t beat8(accum88 beats_per_minute, uint32_t timebase = 0)
+{
+	return uint8_t(beat16(beats_per_minute, timebase) >> 8);
+}
+
+inline uint16_t beatsin88(accum88 beats_per_minute_88, uint16_t lowest = 0, uint16_t highest = 65535,
+						  uint32_t timebase = 0, uint16_t phase_offset = 0)
+{
+	const uint16_t beat = beat88(beats_per_minute_88, timebase);
+	const uint16_t beatsin = uint16_t(sin16(uint16_t(beat + phase_offset)) + 32768);
+	return uint16_t(lowest + scale16(beatsin, uint16_t(highest - lowest)));
+}
+
+inline uint16_t beatsin16(accum88 beats_per_minute, uint16_t lowest = 0, uint16_t highest = 65535,
+						  uint32_t timebase = 0, uint16_t phase_offset = 0)
+{
+	const uint16_t beat = beat16(beats_per_minute, timebase);
+	const uint16_t beatsin = uint16_t(sin16(uint16_t(beat + phase_offset)) + 32768);
+	return uint16_t(lowest + scale16(beatsin, uint16_t(highest - lowest)));
+}
 
-int16_t sin16(uint16_t x);
-inline int16_t cos16(uint16_t x)
+inline uint8_t beatsin8(accum88 beats_per_minute, uint8_t lowest = 0, uint8_t highest = 255,
+						uint32_t timebase = 0, uint8_t phase_offset = 0)
 {
-	return sin16(x + 16384);
+	const uint8_t beat = beat8(beats_per_minute, timebase);
+	const uint8_t beatsin = sin8(uint8_t(beat + phase_offset));
+	return uint8_t(lowest + scale8(beatsin, uint8_t(highest - lowest)));
 }
 
-int8_t sin8(uint8_t x);
-inline int8_t cos8(uint8_t x)
+inline uint16_t seconds16() { return uint16_t(GET_MILLIS() / 1000); }
+inline uint16_t minutes16() { return uint16_t(GET_MILLIS() / 60000); }
+
+//------------------------------------------------------------------------------
+// pixeltypes
+//------------------------------------------------------------------------------
+
+struct CRGB;
+struct CHSV;
+
+void hsv2rgb_rainbow(const CHSV &hsv, CRGB &rgb);
+void hsv2rgb_rainbow(const CHSV *phsv, CRGB *prgb, int numLeds);
+void hsv2rgb_spectrum(const CHSV &hsv, CRGB &rgb);
+void hsv2rgb_raw(const CHSV &hsv, CRGB &rgb);
+CHSV rgb2hsv_approximate(const CRGB &rgb);
+
+typedef enum
+{
+	HUE_RED = 0,
+	HUE_ORANGE = 32,
+	HUE_YELLOW = 64,
+	HUE_GREEN = 96,
+	HUE_AQUA = 128,
+	HUE_BLUE = 160,
+	HUE_PURPLE = 192,
+	HUE_PINK = 224
+} HSVHue;
+
+typedef enum
+{
+	TypicalSMD5050 = 0xFFB0F0,
+	TypicalLEDStrip = 0xFFB0F0,
+	Typical8mmPixel = 0xFFE08C,
+	TypicalPixelString = 0xFFE08C,
+	UncorrectedColor = 0xFFFFFF
+} LEDColorCorrection;
+
+typedef enum
+{
+	Candle = 0xFF9329,
+	Tungsten40W = 0xFFC58F,
+	Tungsten100W = 0xFFD6AA,
+	Halogen = 0xFFF1E0,
+	CarbonArc = 0xFFFAF4,
+	HighNoonSun = 0xFFFFFB,
+	DirectSunlight = 0xFFFFFF,
+	OvercastSky = 0xC9E2FF,
+	ClearBlueSky = 0x409CFF,
+	WarmFluorescent = 0xFFF4E5,
+	StandardFluorescent = 0xF4FFFA,
+	CoolWhiteFluorescent = 0xD4EBFF,
+	FullSpectrumFluorescent = 0xFFF4F2,
+	GrowLightFluorescent = 0xFFEFF7,
+	BlackLightFluorescent = 0xA700FF,
+	MercuryVapor = 0xD8F7FF,
+	SodiumVapor = 0xFFD1B2,
+	MetalHalide = 0xF2FCFF,
+	HighPressureSodium = 0xFFB74C,
+	UncorrectedTemperature = 0xFFFFFF
+} ColorTemperature;
+
+/// Representation of an HSV pixel (hue, saturation, value (aka brightness)).
+struct CHSV
+{
+	union
+	{
+		struct
+		{
+			union
+			{
+				uint8_t hue;
+				uint8_t h;
+			};
+			union
+			{
+				uint8_t saturation;
+				uint8_t sat;
+				uint8_t s;
+			};
+			union
+			{
+				uint8_t value;
+				uint8_t val;
+				uint8_t v;
+			};
+		};
+		uint8_t raw[3];
+	};
+
+	CHSV() = default;
+	constexpr CHSV(uint8_t ih, uint8_t is, uint8_t iv) : h(ih), s(is), v(iv) {}
+
+	uint8_t &operator[](uint8_t x) { return raw[x]; }
+	const uint8_t &operator[](uint8_t x) const { return raw[x]; }
+
+	CHSV &setHSV(uint8_t ih, uint8_t is, uint8_t iv)
+	{
+		h = ih;
+		s = is;
+		v = iv;
+		return *this;
+	}
+};
+
+/// Representation of an RGB pixel.
+struct CRGB
+{
+	union
+	{
+		struct
+		{
+			union
+			{
+				uint8_t r;
+				uint8_t red;
+			};
+			union
+			{
+				uint8_t g;
+				uint8_t green;
+			};
+			union
+			{
+				uint8_t b;
+				uint8_t blue;
+			};
+		};
+		uint8_t raw[3];
+	};
+
+	uint8_t &operator[](uint8_t x) { return raw[x]; }
+	const uint8_t &operator[](uint8_t x) const { return raw[x]; }
+
+	CRGB() = default;
+	constexpr CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+	constexpr CRGB(uint32_t colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b((colorcode >> 0) & 0xFF) {}
+	constexpr CRGB(LEDColorCorrection colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b((colorcode >> 0) & 0xFF) {}
+	constexpr CRGB(ColorTemperature colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b((colorcode >> 0) & 0xFF) {}
+	CRGB(const CHSV &rhs) { hsv2rgb_rainbow(rhs, *this); }
+
+	CRGB &operator=(const CHSV &rhs)
+	{
+		hsv2rgb_rainbow(rhs, *this);
+		return *this;
+	}
+
+	CRGB &operator=(uint32_t colorcode)
+	{
+		return setColorCode(colorcode);
+	}
+
+	CRGB &setRGB(uint8_t nr, uint8_t ng, uint8_t nb)
+	{
+		r = nr;
+		g = ng;
+		b = nb;
+		return *this;
+	}
+
+	CRGB &setHSV(uint8_t hue, uint8_t sat, uint8_t val)
+	{
+		hsv2rgb_rainbow(CHSV(hue, sat, val), *this);
+		return *this;
+	}
+
+	CRGB &setHue(uint8_t hue)
+	{
+		hsv2rgb_rainbow(CHSV(hue, 255, 255), *this);
+		return *this;
+	}
+
+	CRGB &setColorCode(uint32_t colorcode)
+	{
+		r = (colorcode >> 16) & 0xFF;
+		g = (colorcode >> 8) & 0xFF;
+		b = (colorcode >> 0) & 0xFF;
+		return *this;
+	}
+
+	CRGB &operator+=(const CRGB &rhs)
+	{
+		r = qadd8(r, rhs.r);
+		g = qadd8(g, rhs.g);
+		b = qadd8(b, rhs.b);
+		return *this;
+	}
+
+	CRGB &addToRGB(uint8_t d)
+	{
+		r = qadd8(r, d);
+		g = qadd8(g, d);
+		b = qadd8(b, d);
+		return *this;
+	}
+
+	CRGB &operator-=(const CRGB &rhs)
+	{
+		r = qsub8(r, rhs.r);
+		g = qsub8(g, rhs.g);
+		b = qsub8(b, rhs.b);
+		return *this;
+	}
+
+	CRGB &subtractFromRGB(uint8_t d)
+	{
+		r = qsub8(r, d);
+		g = qsub8(g, d);
+		b = qsub8(b, d);
+		return *this;
+	}
+
+	CRGB &operator--() { return subtractFromRGB(1); }
+	CRGB operator--(int)
+	{
+		CRGB retval(*this);
+		--(*this);
+		return retval;
+	}
+
+	CRGB &operator++() { return addToRGB(1); }
+	CRGB operator++(int)
+	{
+		CRGB retval(*this);
+		++(*this);
+		return retval;
+	}
+
+	CRGB &operator/=(uint8_t d)
+	{
+		r /= d;
+		g /= d;
+		b /= d;
+		return *this;
+	}
+
+	CRGB &operator>>=(uint8_t d)
+	{
+		r >>= d;
+		g >>= d;
+		b >>= d;
+		return *this;
+	}
+
+	CRGB &operator*=(uint8_t d)
+	{
+		r = qmul8(r, d);
+		g = qmul8(g, d);
+		b = qmul8(b, d);
+		return *this;
+	}
+
+	CRGB &nscale8_video(uint8_t scaledown)
+	{
+		nscale8x3_video(r, g, b, scaledown);
+		return *this;
+	}
+
+	CRGB &operator%=(uint8_t scaledown) { return nscale8_video(scaledown); }
+
+	CRGB &fadeLightBy(uint8_t fadefactor)
+	{
+		nscale8x3_video(r, g, b, 255 - fadefactor);
+		return *this;
+	}
+
+	CRGB &nscale8(uint8_t scaledown)
+	{
+		nscale8x3(r, g, b, scaledown);
+		return *this;
+	}
+
+	CRGB &nscale8(const CRGB &scaledown)
+	{
+		r = ::scale8(r, scaledown.r);
+		g = ::scale8(g, scaledown.g);
+		b = ::scale8(b, scaledown.b);
+		return *this;
+	}
+
+	CRGB scale8(uint8_t scaledown) const
+	{
+		CRGB out = *this;
+		nscale8x3(out.r, out.g, out.b, scaledown);
+		return out;
+	}
+
+	CRGB scale8(const CRGB &scaledown) const
+	{
+		return CRGB(::scale8(r, scaledown.r), ::scale8(g, scaledown.g), ::scale8(b, scaledown.b));
+	}
+
+	CRGB &fadeToBlackBy(uint8_t fadefactor)
+	{
+		nscale8x3(r, g, b, 255 - fadefactor);
+		return *this;
+	}
+
+	CRGB &operator|=(const CRGB &rhs)
+	{
+		if (rhs.r > r)
+			r = rhs.r;
+		if (rhs.g > g)
+			g = rhs.g;
+		if (rhs.b > b)
+			b = rhs.b;
+		return *this;
+	}
+
+	CRGB &operator|=(uint8_t d)
+	{
+		if (d > r)
+			r = d;
+		if (d > g)
+			g = d;
+		if (d > b)
+			b = d;
+		return *this;
+	}
+
+	CRGB &operator&=(const CRGB &rhs)
+	{
+		if (rhs.r < r)
+			r = rhs.r;
+		if (rhs.g < g)
+			g = rhs.g;
+		if (rhs.b < b)
+			b = rhs.b;
+		return *this;
+	}
+
+	CRGB &operator&=(uint8_t d)
+	{
+		if (d < r)
+			r = d;
+		if (d < g)
+			g = d;
+		if (d < b)
+			b = d;
+		return *this;
+	}
+
+	explicit operator bool() const { return r || g || b; }
+
+	CRGB operator-() const { return CRGB(255 - r, 255 - g, 255 - b); }
+
+	uint8_t getLuma() const
+	{
+		return uint8_t(::scale8(r, 54) + ::scale8(g, 183) + ::scale8(b, 18));
+	}
+
+	uint8_t getAverageLight() const
+	{
+		return uint8_t(::scale8(r, 85) + ::scale8(g, 85) + ::scale8(b, 85));
+	}
+
+	void maximizeBrightness(uint8_t limit = 255)
+	{
+		uint8_t max = r;
+		if (g > max)
+			max = g;
+		if (b > max)
+			max = b;
+		if (max == 0)
+			return;
+		const uint16_t factor = uint16_t((uint16_t(limit) * 256) / max);
+		r = uint8_t((r * factor) / 256);
+		g = uint8_t((g * factor) / 256);
+		b = uint8_t((b * factor) / 256);
+	}
+
+	CRGB lerp8(const CRGB &other, fract8 frac) const
+	{
+		return CRGB(lerp8by8(r, other.r, frac), lerp8by8(g, other.g, frac), lerp8by8(b, other.b, frac));
+	}
+
+	typedef enum
+	{
+		AliceBlue = 0xF0F8FF,
+		Amethyst = 0x9966CC,
+		AntiqueWhite = 0xFAEBD7,
+		Aqua = 0x00FFFF,
+		Aquamarine = 0x7FFFD4,
+		Azure = 0xF0FFFF,
+		Beige = 0xF5F5DC,
+		Bisque = 0xFFE4C4,
+		Black = 0x000000,
+		BlanchedAlmond = 0xFFEBCD,
+		Blue = 0x0000FF,
+		BlueViolet = 0x8A2BE2,
+		Brown = 0xA52A2A,
+		BurlyWood = 0xDEB887,
+		CadetBlue = 0x5F9EA0,
+		Chartreuse = 0x7FFF00,
+		Chocolate = 0xD2691E,
+		Coral = 0xFF7F50,
+		CornflowerBlue = 0x6495ED,
+		Cornsilk = 0xFFF8DC,
+		Crimson = 0xDC143C,
+		Cyan = 0x00FFFF,
+		DarkBlue = 0x00008B,
+		DarkCyan = 0x008B8B,
+		DarkGoldenrod = 0xB8860B,
+		DarkGray = 0xA9A9A9,
+		DarkGrey = 0xA9A9A9,
+		DarkGreen = 0x006400,
+		DarkKhaki = 0xBDB76B,
+		DarkMagenta = 0x8B008B,
+		DarkOliveGreen = 0x556B2F,
+		DarkOrange = 0xFF8C00,
+		DarkOrchid = 0x9932CC,
+		DarkRed = 0x8B0000,
+		DarkSalmon = 0xE9967A,
+		DarkSeaGreen = 0x8FBC8F,
+		DarkSlateBlue = 0x483D8B,
+		DarkSlateGray = 0x2F4F4F,
+		DarkSlateGrey = 0x2F4F4F,
+		DarkTurquoise = 0x00CED1,
+		DarkViolet = 0x9400D3,
+		DeepPink = 0xFF1493,
+		DeepSkyBlue = 0x00BFFF,
+		DimGray = 0x696969,
+		DimGrey = 0x696969,
+		DodgerBlue = 0x1E90FF,
+		FireBrick = 0xB22222,
+		FloralWhite = 0xFFFAF0,
+		ForestGreen = 0x228B22,
+		Fuchsia = 0xFF00FF,
+		Gainsboro = 0xDCDCDC,
+		GhostWhite = 0xF8F8FF,
+		Gold = 0xFFD700,
+		Goldenrod = 0xDAA520,
+		Gray = 0x808080,
+		Grey = 0x808080,
+		Green = 0x008000,
+		GreenYellow = 0xADFF2F,
+		Honeydew = 0xF0FFF0,
+		HotPink = 0xFF69B4,
+		IndianRed = 0xCD5C5C,
+		Indigo = 0x4B0082,
+		Ivory = 0xFFFFF0,
+		Khaki = 0xF0E68C,
+		Lavender = 0xE6E6FA,
+		LavenderBlush = 0xFFF0F5,
+		LawnGreen = 0x7CFC00,
+		LemonChiffon = 0xFFFACD,
+		LightBlue = 0xADD8E6,
+		LightCoral = 0xF08080,
+		LightCyan = 0xE0FFFF,
+		LightGoldenrodYellow = 0xFAFAD2,
+		LightGreen = 0x90EE90,
+		LightGrey = 0xD3D3D3,
+		LightPink = 0xFFB6C1,
+		LightSalmon = 0xFFA07A,
+		LightSeaGreen = 0x20B2AA,
+		LightSkyBlue = 0x87CEFA,
+		LightSlateGray = 0x778899,
+		LightSlateGrey = 0x778899,
+		LightSteelBlue = 0xB0C4DE,
+		LightYellow = 0xFFFFE0,
+		Lime = 0x00FF00,
+		LimeGreen = 0x32CD32,
+		Linen = 0xFAF0E6,
+		Magenta = 0xFF00FF,
+		Maroon = 0x800000,
+		MediumAquamarine = 0x66CDAA,
+		MediumBlue = 0x0000CD,
+		MediumOrchid = 0xBA55D3,
+		MediumPurple = 0x9370DB,
+		MediumSeaGreen = 0x3CB371,
+		MediumSlateBlue = 0x7B68EE,
+		MediumSpringGreen = 0x00FA9A,
+		MediumTurquoise = 0x48D1CC,
+		MediumVioletRed = 0xC71585,
+		MidnightBlue = 0x191970,
+		MintCream = 0xF5FFFA,
+		MistyRose = 0xFFE4E1,
+		Moccasin = 0xFFE4B5,
+		NavajoWhite = 0xFFDEAD,
+		Navy = 0x000080,
+		OldLace = 0xFDF5E6,
+		Olive = 0x808000,
+		OliveDrab = 0x6B8E23,
+		Orange = 0xFFA500,
+		OrangeRed = 0xFF4500,
+		Orchid = 0xDA70D6,
+		PaleGoldenrod = 0xEEE8AA,
+		PaleGreen = 0x98FB98,
+		PaleTurquoise = 0xAFEEEE,
+		PaleVioletRed = 0xDB7093,
+		PapayaWhip = 0xFFEFD5,
+		PeachPuff = 0xFFDAB9,
+		Peru = 0xCD853F,
+		Pink = 0xFFC0CB,
+		Plaid = 0xCC5533,
+		Plum = 0xDDA0DD,
+		PowderBlue = 0xB0E0E6,
+		Purple = 0x800080,
+		Red = 0xFF0000,
+		RosyBrown = 0xBC8F8F,
+		RoyalBlue = 0x4169E1,
+		SaddleBrown = 0x8B4513,
+		Salmon = 0xFA8072,
+		SandyBrown = 0xF4A460,
+		SeaGreen = 0x2E8B57,
+		Seashell = 0xFFF5EE,
+		Sienna = 0xA0522D,
+		Silver = 0xC0C0C0,
+		SkyBlue = 0x87CEEB,
+		SlateBlue = 0x6A5ACD,
+		SlateGray = 0x708090,
+		SlateGrey = 0x708090,
+		Snow = 0xFFFAFA,
+		SpringGreen = 0x00FF7F,
+		SteelBlue = 0x4682B4,
+		Tan = 0xD2B48C,
+		Teal = 0x008080,
+		Thistle = 0xD8BFD8,
+		Tomato = 0xFF6347,
+		Turquoise = 0x40E0D0,
+		Violet = 0xEE82EE,
+		Wheat = 0xF5DEB3,
+		White = 0xFFFFFF,
+		WhiteSmoke = 0xF5F5F5,
+		Yellow = 0xFFFF00,
+		YellowGreen = 0x9ACD32,
+		FairyLight = 0xFFE42D,
+		FairyLightNCC = 0xFF9D2A
+	} HTMLColorCode;
+};
+
+inline bool operator==(const CRGB &lhs, const CRGB &rhs) { return (lhs.r == rhs.r) && (lhs.g == rhs.g) && (lhs.b == rhs.b); }
+inline bool operator!=(const CRGB &lhs, const CRGB &rhs) { return !(lhs == rhs); }
+inline bool operator==(const CHSV &lhs, const CHSV &rhs) { return (lhs.h == rhs.h) && (lhs.s == rhs.s) && (lhs.v == rhs.v); }
+inline bool operator!=(const CHSV &lhs, const CHSV &rhs) { return !(lhs == rhs); }
+
+inline bool operator<(const CRGB &lhs, const CRGB &rhs) { return (lhs.r + lhs.g + lhs.b) < (rhs.r + rhs.g + rhs.b); }
+inline bool operator>(const CRGB &lhs, const CRGB &rhs) { return (lhs.r + lhs.g + lhs.b) > (rhs.r + rhs.g + rhs.b); }
+inline bool operator<=(const CRGB &lhs, const CRGB &rhs) { return !(lhs > rhs); }
+inline bool operator>=(const CRGB &lhs, const CRGB &rhs) { return !(lhs < rhs); }
+
+inline CRGB operator+(const CRGB &p1, const CRGB &p2) { return CRGB(qadd8(p1.r, p2.r), qadd8(p1.g, p2.g), qadd8(p1.b, p2.b)); }
+inline CRGB operator-(const CRGB &p1, const CRGB &p2) { return CRGB(qsub8(p1.r, p2.r), qsub8(p1.g, p2.g), qsub8(p1.b, p2.b)); }
+inline CRGB operator*(const CRGB &p1, uint8_t d) { return CRGB(qmul8(p1.r, d), qmul8(p1.g, d), qmul8(p1.b, d)); }
+inline CRGB operator/(const CRGB &p1, uint8_t d) { return CRGB(p1.r / d, p1.g / d, p1.b / d); }
+inline CRGB operator&(const CRGB &p1, const CRGB &p2) { return CRGB(min(p1.r, p2.r), min(p1.g, p2.g), min(p1.b, p2.b)); }
+inline CRGB operator|(const CRGB &p1, const CRGB &p2) { return CRGB(max(p1.r, p2.r), max(p1.g, p2.g), max(p1.b, p2.b)); }
+inline CRGB operator%(const CRGB &p1, uint8_t d)
 {
-	return sin8(x + 64);
+	CRGB retval(p1);
+	retval.nscale8_video(d);
+	return retval;
 }
 
 //------------------------------------------------------------------------------
+// colorutils
+//------------------------------------------------------------------------------
+
+typedef enum
+{
+	NOBLEND = 0,
+	LINEARBLEND = 1,
+	LINEARBLEND_NOWRAP = 2
+} TBlendType;
+
+typedef uint32_t TProgmemRGBPalette16[16];
+
+/// RGB color palette with 16 discrete values.
+class CRGBPalette16
+{
+public:
+	CRGB entries[16];
+
+	CRGBPalette16() = default;
+	CRGBPalette16(const CRGB &c00, const CRGB &c01, const CRGB &c02, const CRGB &c03,
+				  const CRGB &c04, const CRGB &c05, const CRGB &c06, const CRGB &c07,
+				  const CRGB &c08, const CRGB &c09, const CRGB &c10, const CRGB &c11,
+				  const CRGB &c12, const CRGB &c13, const CRGB &c14, const CRGB &c15)
+		: entries{c00, c01, c02, c03, c04, c05, c06, c07, c08, c09, c10, c11, c12, c13, c14, c15}
+	{
+	}
+	CRGBPalette16(const TProgmemRGBPalette16 &rhs);
+	CRGBPalette16(const CRGB &c1);
+	CRGBPalette16(const CRGB &c1, const CRGB &c2);
+	CRGBPalette16(const CRGB &c1, const CRGB &c2, const CRGB &c3);
+	CRGBPalette16(const CRGB &c1, const CRGB &c2, const CRGB &c3, const CRGB &c4);
+
+	CRGB &operator[](uint8_t x) { return entries[x]; }
+	const CRGB &operator[](uint8_t x) const { return entries[x]; }
+
+	operator CRGB *() { return entries; }
+	operator const CRGB *() const { return entries; }
+
+	bool operator==(const CRGBPalette16 &rhs) const;
+	bool operator!=(const CRGBPalette16 &rhs) const { return !(*this == rhs); }
+};
+
+extern const TProgmemRGBPalette16 CloudColors_p;
+extern const TProgmemRGBPalette16 LavaColors_p;
+extern const TProgmemRGBPalette16 OceanColors_p;
+extern const TProgmemRGBPalette16 ForestColors_p;
+extern const TProgmemRGBPalette16 RainbowColors_p;
+extern const TProgmemRGBPalette16 RainbowStripeColors_p;
+extern const TProgmemRGBPalette16 PartyColors_p;
+extern const TProgmemRGBPalette16 HeatColors_p;
+
+CRGB ColorFromPalette(const CRGBPalette16 &pal, uint8_t index, uint8_t brightness = 255, TBlendType blendType = LINEARBLEND);
+
+CRGB HeatColor(uint8_t temperature);
+
+void fill_solid(CRGB *leds, int numToFill, const CRGB &color);
+void fill_solid(CHSV *targetArray, int numToFill, const CHSV &color);
+void fill_rainbow(CRGB *targetArray, int numToFill, uint8_t initialhue, uint8_t deltahue = 5);
+void fill_gradient_RGB(CRGB *leds, uint16_t startpos, CRGB startcolor, uint16_t endpos, CRGB endcolor);
+void fill_gradient_RGB(CRGB *leds, uint16_t numLeds, const CRGB &c1, const CRGB &c2);
+void fill_gradient_RGB(CRGB *leds, uint16_t numLeds, const CRGB &c1, const CRGB &c2, const CRGB &c3);
+void fill_gradient_RGB(CRGB *leds, uint16_t numLeds, const CRGB &c1, const CRGB &c2, const CRGB &c3, const CRGB &c4);
+void fill_palette(CRGB *L, uint16_t N, uint8_t startIndex, uint8_t incIndex,
+				  const CRGBPalette16 &pal, uint8_t brightness, TBlendType blendType);
+
+void nscale8_video(CRGB *leds, uint16_t num_leds, uint8_t scale);
+void nscale8(CRGB *leds, uint16_t num_leds, uint8_t scale);
+void fadeLightBy(CRGB *leds, uint16_t num_leds, uint8_t fadeBy);
+void fadeToBlackBy(CRGB *leds, uint16_t num_leds, uint8_t fadeBy);
+void fade_video(CRGB *leds, uint16_t num_leds, uint8_t fadeBy);
+void fade_raw(CRGB *leds, uint16_t num_leds, uint8_t fadeBy);
+void fadeUsingColor(CRGB *leds, uint16_t numLeds, const CRGB &colormask);
+
+CRGB &nblend(CRGB &existing, const CRGB &overlay, fract8 amountOfOverlay);
+void nblend(CRGB *existing, CRGB *overlay, uint16_t count, fract8 amountOfOverlay);
+CRGB blend(const CRGB &p1, const CRGB &p2, fract8 amountOfP2);
+
+void blur1d(CRGB *leds, uint16_t numLeds, fract8 blur_amount);
+
+//------------------------------------------------------------------------------
+// noise
+//------------------------------------------------------------------------------
+
+uint16_t inoise16(uint32_t x, uint32_t y, uint32_t z);
+uint16_t inoise16(uint32_t x, uint32_t y);
+uint16_t inoise16(uint32_t x);
+int16_t inoise16_raw(uint32_t x, uint32_t y, uint32_t z);
+int16_t inoise16_raw(uint32_t x, uint32_t y);
+int16_t inoise16_raw(uint32_t x);
+
+uint8_t inoise8(uint16_t x, uint16_t y, uint16_t z);
+uint8_t inoise8(uint16_t x, uint16_t y);
+uint8_t inoise8(uint16_t x);
+int8_t inoise8_raw(uint16_t x, uint16_t y, uint16_t z);
+int8_t inoise8_raw(uint16_t x, uint16_t y);
+int8_t inoise8_raw(uint16_t x);
+
+//------------------------------------------------------------------------------
+// controller
+//------------------------------------------------------------------------------
+
+enum EOrder
+{
+	RGB = 0012,
+	RBG = 0021,
+	GRB = 0102,
+	GBR = 0120,
+	BRG = 0201,
+	BGR = 0210
+};
+
+// Only the type matters for the emulation; the actual protocol is not emulated.
+#define EC_EMU_CLOCKLESS_CHIPSET(CHIPSET, DEFAULT_ORDER)         \
+	template <uint8_t DATA_PIN, EOrder RGB_ORDER = DEFAULT_ORDER> \
+	class CHIPSET                                                 \
+	{                                                             \
+	}
+
+EC_EMU_CLOCKLESS_CHIPSET(WS2811, RGB);
+EC_EMU_CLOCKLESS_CHIPSET(WS2811_400, RGB);
+EC_EMU_CLOCKLESS_CHIPSET(WS2812, GRB);
+EC_EMU_CLOCKLESS_CHIPSET(WS2812B, GRB);
+EC_EMU_CLOCKLESS_CHIPSET(WS2813, GRB);
+EC_EMU_CLOCKLESS_CHIPSET(WS2815, GRB);
+EC_EMU_CLOCKLESS_CHIPSET(SK6812, GRB);
+EC_EMU_CLOCKLESS_CHIPSET(SK6822, RGB);
+EC_EMU_CLOCKLESS_CHIPSET(APA106, RGB);
+EC_EMU_CLOCKLESS_CHIPSET(PL9823, RGB);
+EC_EMU_CLOCKLESS_CHIPSET(TM1803, RGB);
+EC_EMU_CLOCKLESS_CHIPSET(TM1804, RGB);
+EC_EMU_CLOCKLESS_CHIPSET(TM1809, RGB);
+EC_EMU_CLOCKLESS_CHIPSET(UCS1903, RGB);
+EC_EMU_CLOCKLESS_CHIPSET(UCS1903B, RGB);
+EC_EMU_CLOCKLESS_CHIPSET(UCS1904, RGB);
+EC_EMU_CLOCKLESS_CHIPSET(GW6205, RGB);
+
+#undef EC_EMU_CLOCKLESS_CHIPSET
+
+template <uint8_t DATA_PIN>
+class NEOPIXEL
+{
+};
+
+/// Bookkeeping of one LED strip that was registered with FastLED.addLeds()
+class CLEDController
+{
+public:
+	CLEDController() = default;
+	CLEDController(CRGB *data, int nLeds) : m_data(data), m_nLeds(nLeds) {}
+
+	CLEDController &setCorrection(CRGB correction)
+	{
+		m_colorCorrection = correction;
+		return *this;
+	}
+	CLEDController &setCorrection(LEDColorCorrection correction) { return setCorrection(CRGB(correction)); }
+	CRGB getCorrection() { return m_colorCorrection; }
+
+	CLEDController &setTemperature(CRGB temperature)
+	{
+		m_colorTemperature = temperature;
+		return *this;
+	}
+	CLEDController &setTemperature(ColorTemperature temperature) { return setTemperature(CRGB(temperature)); }
+	CRGB getTemperature() { return m_colorTemperature; }
+
+	CLEDController &setDither(uint8_t ditherMode = 1)
+	{
+		(void)ditherMode;
+		return *this;
+	}
+
+	CLEDController &setLeds(CRGB *data, int nLeds)
+	{
+		m_data = data;
+		m_nLeds = nLeds;
+		return *this;
+	}
+
+	CRGB *leds() { return m_data; }
+	int size() { return m_nLeds; }
+	CRGB &operator[](int x) { return m_data[x]; }
+
+	void clearLeds(int nLeds);
+
+private:
+	CRGB *m_data = nullptr;
+	int m_nLeds = 0;
+	CRGB m_colorCorrection = CRGB(UncorrectedColor);
+	CRGB m_colorTemperature = CRGB(UncorrectedTemperature);
+};
+
+/// Receives the content of all LED strips when FastLED.show() is called.
+/// This is an extension of the emulation; not available with the real FastLED.
+class CEmuFrameSink
+{
+public:
+	virtual ~CEmuFrameSink() = default;
+
+	/** Called by FastLED.show() for each LED strip.
+	 * @param controller  The LED strip.
+	 * @param brightness  Global brightness with which the strip is shown.
+	 */
+	virtual void showFrame(CLEDController &controller, uint8_t brightness) = 0;
+};
+
+/// The global FastLED object.
+class CFastLED
+{
+public:
+	static const uint8_t MAX_CONTROLLERS = 8;
+	static const uint8_t MAX_FRAME_SINKS = 4;
+
+	template <template <uint8_t DATA_PIN, EOrder RGB_ORDER> class CHIPSET, uint8_t DATA_PIN, EOrder RGB_ORDER>
+	CLEDController &addLeds(CRGB *data, int nLedsOrOffset, int nLedsIfOffset = 0)
+	{
+		return addLeds(data, nLedsOrOffset, nLedsIfOffset);
+	}
+
+	template <template <uint8_t DATA_PIN, EOrder RGB_ORDER> class CHIPSET, uint8_t DATA_PIN>
+	CLEDController &addLeds(CRGB *data, int nLedsOrOffset, int nLedsIfOffset = 0)
+	{
+		return addLeds(data, nLedsOrOffset, nLedsIfOffset);
+	}
+
+	template <template <uint8_t DATA_PIN> class CHIPSET, uint8_t DATA_PIN>
+	CLEDController &addLeds(CRGB *data, int nLedsOrOffset, int nLedsIfOffset = 0)
+	{
+		return addLeds(data, nLedsOrOffset, nLedsIfOffset);
+	}
+
+	void setBrightness(uint8_t scale) { m_Scale = scale; }
+	uint8_t getBrightness() { return m_Scale; }
+
+	void setMaxPowerInVoltsAndMilliamps(uint8_t volts, uint32_t milliamps) { (void)volts, (void)milliamps; }
+	void setMaxPowerInMilliWatts(uint32_t milliwatts) { (void)milliwatts; }
+	void setMaxRefreshRate(uint16_t refresh, bool constrain = false) { (void)refresh, (void)constrain; }
+	void setCorrection(const CRGB &correction);
+	void setTemperature(const CRGB &temp);
+	void setDither(uint8_t ditherMode = 1) { (void)ditherMode; }
+
+	void show(uint8_t scale);
+	void show() { show(m_Scale); }
+
+	void clear(bool writeData = false);
+	void clearData();
+	void showColor(const CRGB &color, uint8_t scale);
+	void showColor(const CRGB &color) { showColor(color, m_Scale); }
+
+	void delay(unsigned long ms);
+
+	void countFPS(int nFrames = 25);
+	uint16_t getFPS() { return m_nFPS; }
+
+	int count() { return m_nControllers; }
+	CLEDController &operator[](int x);
+	int size();
+	CRGB *leds();
+
+	// Emulation only:
+
+	/// Register a \a sink that receives all frames; returns false when there is no room.
+	bool addFrameSink(CEmuFrameSink &sink);
+
+	/// Unregister a previously registered \a sink.
+	void removeFrameSink(CEmuFrameSink &sink);
+
+	/// Number of show() calls so far.
+	uint32_t getShowCount() { return m_nShowCount; }
+
+	/// Number of LEDs that were transmitted by all show() calls so far (summed over all strips).
+	uint64_t getTransmittedLedCount() { return m_nTransmittedLeds; }
+
+	/// Number of counted operations of the given type so far.
+	uint32_t getOpCount(EEmuOp op) { return emuOpCounts[op]; }
+
+	/// Reset all operation counters.
+	void resetOpCounts();
+
+private:
+	CLEDController &addLeds(CRGB *data, int nLedsOrOffset, int nLedsIfOffset);
+
+	CLEDController m_Controllers[MAX_CONTROLLERS];
+	CEmuFrameSink *m_FrameSinks[MAX_FRAME_SINKS] = {};
+	uint32_t m_nShowCount = 0;
+	uint64_t m_nTransmittedLeds = 0;
+	uint8_t m_nControllers = 0;
+	uint8_t m_Scale = 255;
+	uint16_t m_nFPS = 0;
+};
+
+extern CFastLED FastLED;
+
+//------------------------------------------------------------------------------
+
+/// Helper for the EVERY_N_MILLISECONDS() & co. macros.
+template <unsigned long (*timeGetter)()>
+class CEveryNTime
+{
+public:
+	explicit CEveryNTime(unsigned long period) : mPeriod(period), mPrevTrigger(timeGetter()) {}
+
+	unsigned long getTime() { return timeGetter(); }
+	unsigned long getPeriod() { return mPeriod; }
+	void setPeriod(unsigned long period) { mPeriod = period; }
+	unsigned long getElapsed() { return getTime() - mPrevTrigger; }
+	unsigned long getRemaining() { return mPeriod - getElapsed(); }
+	void reset() { mPrevTrigger = getTime(); }
+	void trigger() { mPrevTrigger = getTime() - mPeriod; }
+
+	bool ready()
+	{
+		const bool isReady = (getElapsed() >= mPeriod);
+		if (isReady)
+		{
+			reset();
+		}
+		return isReady;
+	}
+
+	operator bool() { return ready(); }
+
+private:
+	unsigned long mPeriod;
+	unsigned long mPrevTrigger;
+};
 
-// hide content of original headerfiles
-#define __INC_FASTSPI_LED2_H
-#define __INC_LED_SYSDEFS_H
+inline unsigned long emu_seconds() { return millis() / 1000; }
 
-// some other stuff to disable
-#define FASTLED_NAMESPACE_BEGIN
-#define FASTLED_NAMESPACE_END
-#define FASTLED_USING_NAMESPACE
-#define __attribute__(x)
+typedef CEveryNTime<millis> CEveryNMillis;
+typedef CEveryNTime<emu_seconds> CEveryNSeconds;
 
-#include "../../../FastLED/pixeltypes.h"
+#define CONCAT_HELPER(x, y) x##y
+#define CONCAT_MACRO(x, y) CONCAT_HELPER(x, y)
+#define EVERY_N_MILLIS(N) EVERY_N_MILLIS_I(CONCAT_MACRO(PER, __COUNTER__), N)
+#define EVERY_N_MILLIS_I(NAME, N)    \
+	static CEveryNMillis NAME(N); \
+	if (NAME)
+#define EVERY_N_SECONDS(N) EVERY_N_SECONDS_I(CONCAT_MACRO(PER, __COUNTER__), N)
+#define EVERY_N_SECONDS_I(NAME, N)    \
+	static CEveryNSeconds NAME(N); \
+	if (NAME)
+#define EVERY_N_MILLISECONDS(N) EVERY_N_MILLIS(N)
+#define EVERY_N_MILLISECONDS_I(NAME, N) EVERY_N_MILLIS_I(NAME, N)
 
 //------------------------------------------------------------------------------
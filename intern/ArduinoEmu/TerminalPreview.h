@@ -0,0 +1,133 @@
+#pragma once
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+/* Live preview of the LED strips in a terminal, using ANSI 24 bit colors.
+ * Works in any terminal with truecolor support (xterm, GNOME Terminal, Windows
+ * Terminal, tmux, ...), also via SSH. This is an extension of the emulation;
+ * not available with the real FastLED.
+ */
+
+#include "FastLED.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+/** Draws every LED strip as a block of colored cells into the terminal.
+ * Each LED is one character cell; long strips wrap over multiple rows.
+ *
+ * To keep the cost low (and out of the profile of the Animations), frames are
+ * throttled to a maximum rate, and only the cells that changed since the last
+ * drawn frame are redrawn. The output of one frame is written at once.
+ *
+ * The preview is drawn below the current cursor position, and the cursor is
+ * parked in the line below the preview. Other output to the same terminal
+ * (like Serial) messes up the preview; call restart() afterwards.
+ */
+class CEmuTerminalPreview : public CEmuFrameSink
+{
+public:
+	/** Constructor.
+	 * @param file  Where to draw the preview, usually stdout or stderr.
+	 * @param maxFps  Maximum frame rate of the preview (in real time); 0 = unlimited.
+	 * @param columns  Width of the preview; 0 = terminal width.
+	 */
+	explicit CEmuTerminalPreview(FILE *file = stdout, uint16_t maxFps = 30, uint16_t columns = 0);
+
+	/// Restores the terminal's cursor and colors.
+	~CEmuTerminalPreview();
+
+	/// Register at the global FastLED object, so that all frames are previewed.
+	bool attach() { return FastLED.addFrameSink(*this); }
+
+	/// Unregister from the global FastLED object.
+	void detach() { FastLED.removeFrameSink(*this); }
+
+	/// Scale the colors with FastLED's brightness (default: true).
+	void setApplyBrightness(bool applyBrightness) { m_bApplyBrightness = applyBrightness; }
+
+	/// Forget what is on the screen; the next frame is drawn completely, below the cursor.
+	void restart();
+
+	/** Draw the given LEDs immediately, ignoring the frame rate limit.
+	 * Each LED array gets its own block in the preview. Useful for any FastLedStrip,
+	 * also when it is not shown via FastLED.show(): draw(strip.ledArray(), strip.ledCount())
+	 */
+	void draw(const CRGB *leds, int nLeds, uint8_t brightness = 255);
+
+	/// Called by FastLED.show(); throttled to the maximum frame rate.
+	void showFrame(CLEDController &controller, uint8_t brightness) override;
+
+	/// Number of frames that were drawn.
+	uint32_t getDrawnFrames() const { return m_nDrawnFrames; }
+
+	/// Number of frames that were skipped due to the frame rate limit.
+	uint32_t getSkippedFrames() const { return m_nSkippedFrames; }
+
+	/// Number of bytes written to the terminal.
+	uint64_t getBytesWritten() const { return m_nBytesWritten; }
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	/// Screen content of one LED strip.
+	struct Block
+	{
+		const void *key = nullptr;
+		uint16_t firstRow = 0;
+		uint16_t rows = 0;
+		std::vector<CRGB> cells;
+	};
+
+	Block &getBlock(const void *key, int nLeds);
+	void drawBlock(Block &block, const CRGB *leds, int nLeds, uint8_t brightness);
+	void appendColor(const CRGB &color);
+	void flush();
+
+	FILE *m_pFile;
+	Clock::duration m_FrameInterval;
+	Clock::time_point m_LastFrameTime;
+	uint16_t m_nColumns;
+	uint16_t m_nRows = 0;
+	bool m_bApplyBrightness = true;
+	bool m_bDrawCurrentShow = false;
+	uint32_t m_nCurrentShow = 0;
+
+	std::vector<Block> m_Blocks;
+	std::string m_Output;
+	CRGB m_LastColor;
+	bool m_bColorValid = false;
+
+	uint32_t m_nDrawnFrames = 0;
+	uint32_t m_nSkippedFrames = 0;
+	uint64_t m_nBytesWritten = 0;
+};
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,105 @@
+# Converts an Arduino sketch (*.ino) into a C++ source file, like the Arduino
+# IDE does during the build:
+# - Prepend #include <Arduino.h>
+# - Insert prototypes of all functions just before the first function definition
+#   (so that functions can be used before they are defined).
+#
+# Usage: cmake -DINO_FILE=<sketch.ino> -DCPP_FILE=<output.cpp> -P ino2cpp.cmake
+#
+# Like the Arduino IDE, this is just a heuristic that works for sketches that
+# are formatted in the usual way: function definitions start at column 0, with
+# the opening brace on the same or on the next line. Templates are skipped.
+
+if(NOT INO_FILE OR NOT CPP_FILE)
+  message(FATAL_ERROR "Usage: cmake -DINO_FILE=<sketch.ino> -DCPP_FILE=<output.cpp> -P ino2cpp.cmake")
+endif()
+
+cmake_policy(SET CMP0007 NEW)
+
+file(READ "${INO_FILE}" content)
+
+# Characters with special meaning in CMake lists
+string(REPLACE "\r" "" content "${content}")
+string(REPLACE "\\" "@EC_BSL@" content "${content}")
+string(REPLACE ";" "@EC_SEM@" content "${content}")
+string(REPLACE "[" "@EC_LBR@" content "${content}")
+string(REPLACE "]" "@EC_RBR@" content "${content}")
+string(REPLACE "\n" ";" lines "${content}")
+
+set(keywords "^(if|else|for|while|do|switch|case|return|template|typedef|using|class|struct|union|enum|namespace|static_assert|extern)[^A-Za-z0-9_]")
+set(function_header "^[A-Za-z_][A-Za-z0-9_:<>,@ \\*&]*[ \\*&]+[A-Za-z_][A-Za-z0-9_]*[ ]*\\((.*)\\)[ ]*(const)?[ ]*({)?[ ]*$")
+
+list(LENGTH lines line_count)
+set(prototypes "")
+set(insert_line -1)
+set(in_comment FALSE)
+set(prev_line "")
+
+math(EXPR last_index "${line_count} - 1")
+foreach(idx RANGE ${last_index})
+  list(GET lines ${idx} line)
+
+  if(in_comment)
+    if("${line}" MATCHES "\\*/")
+      set(in_comment FALSE)
+    endif()
+  elseif("${line}" MATCHES "^[ \t]*/\\*" AND NOT "${line}" MATCHES "\\*/")
+    set(in_comment TRUE)
+  elseif("${line}" MATCHES "${function_header}" AND NOT "${line}" MATCHES "${keywords}"
+         AND NOT "${prev_line}" MATCHES "^template[ ]*<")
+    set(has_body FALSE)
+    if("${line}" MATCHES "{[ ]*$")
+      set(has_body TRUE)
+    elseif(idx LESS last_index)
+      math(EXPR next_idx "${idx} + 1")
+      list(GET lines ${next_idx} next_line)
+      if("${next_line}" MATCHES "^{[ ]*$")
+        set(has_body TRUE)
+      endif()
+    endif()
+
+    if(has_body)
+      # Strip the body's brace and any default arguments
+      string(REGEX REPLACE "[ ]*{[ ]*$" "" proto "${line}")
+      string(REGEX REPLACE "[ ]+$" "" proto "${proto}")
+      string(REGEX MATCH "^[^(]*\\(" proto_head "${proto}")
+      string(REGEX MATCH "\\)[^)]*$" proto_tail "${proto}")
+      string(LENGTH "${proto_head}" head_len)
+      string(LENGTH "${proto}" proto_len)
+      string(LENGTH "${proto_tail}" tail_len)
+      math(EXPR params_len "${proto_len} - ${head_len} - ${tail_len}")
+      string(SUBSTRING "${proto}" ${head_len} ${params_len} params)
+      set(prev_params "")
+      while(NOT "${params}" STREQUAL "${prev_params}")
+        set(prev_params "${params}")
+        string(REGEX REPLACE "(=[^,()]*)\\([^()]*\\)" "\\1" params "${params}")
+      endwhile()
+      string(REGEX REPLACE "[ ]*=[^,]*" "" params "${params}")
+
+      string(APPEND prototypes "${proto_head}${params}${proto_tail}@EC_SEM@\n")
+      if(insert_line LESS 0)
+        set(insert_line ${idx})
+      endif()
+    endif()
+  endif()
+
+  set(prev_line "${line}")
+endforeach()
+
+# Assemble the output
+set(output "#include <Arduino.h>\n#line 1 \"${INO_FILE}\"\n")
+foreach(idx RANGE ${last_index})
+  if(idx EQUAL insert_line)
+    math(EXPR line_no "${idx} + 1")
+    string(APPEND output "${prototypes}#line ${line_no} \"${INO_FILE}\"\n")
+  endif()
+  list(GET lines ${idx} line)
+  string(APPEND output "${line}\n")
+endforeach()
+
+string(REPLACE "@EC_RBR@" "]" output "${output}")
+string(REPLACE "@EC_LBR@" "[" output "${output}")
+string(REPLACE "@EC_SEM@" ";" output "${output}")
+string(REPLACE "@EC_BSL@" "\\" output "${output}")
+
+file(WRITE "${CPP_FILE}" "${output}")
@@ -1,4 +1,3 @@
-
 /*******************************************************************************
 
 MIT License
@@ -25,40 +24,316 @@ SOFTWARE.
 
 *******************************************************************************/
 
-#pragma message("Using Arduino Emulation on PC")
 #include "../Arduino.h"
-// C:\Program Files (x86)\Arduino\hardware\arduino\avr\cores\arduinoArduino.h
 
 #include <chrono>
-#include <cstdlib>
+#include <cstdio>
 #include <thread>
 
 //------------------------------------------------------------------------------
 
-void delay(uint32_t ms)
+namespace
+{
+	typedef std::chrono::steady_clock Clock;
+
+	const Clock::time_point startTime = Clock::now();
+
+	bool useSimulatedClock = false;
+	uint64_t simulatedMicros = 0;
+
+	uint64_t realMicros()
+	{
+		return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - startTime).count());
+	}
+
+	uint64_t currentMicros()
+	{
+		return useSimulatedClock ? simulatedMicros : realMicros();
+	}
+
+	unsigned long nextRandom = 1;
+
+	uint8_t pinModes[NUM_DIGITAL_PINS] = {};
+	bool digitalInputs[NUM_DIGITAL_PINS] = {};
+	bool digitalInputsSet[NUM_DIGITAL_PINS] = {};
+	bool digitalOutputs[NUM_DIGITAL_PINS] = {};
+	uint16_t analogInputs[NUM_DIGITAL_PINS] = {512, 512, 512, 512, 512, 512, 512, 512, 512, 512,
+											   512, 512, 512, 512, 512, 512, 512, 512, 512, 512};
+
+	bool isValidPin(uint8_t pin)
+	{
+		return pin < NUM_DIGITAL_PINS;
+	}
+
+	uint8_t analogPin(uint8_t pin)
+	{
+		// analogRead() accepts both channel numbers and A0...A5
+		return (pin < A0) ? pin + A0 : pin;
+	}
+} // namespace
+
+//------------------------------------------------------------------------------
+
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+	return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+//------------------------------------------------------------------------------
+
+// Both overflow like on a real Arduino.
+unsigned long millis()
+{
+	return (unsigned long)uint32_t(currentMicros() / 1000);
+}
+
+unsigned long micros()
+{
+	return (unsigned long)uint32_t(currentMicros());
+}
+
+void delay(unsigned long ms)
+{
+	if (useSimulatedClock)
+	{
+		simulatedMicros += uint64_t(ms) * 1000;
+	}
+	else
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+	}
+}
+
+void delayMicroseconds(unsigned int us)
+{
+	if (useSimulatedClock)
+	{
+		simulatedMicros += us;
+	}
+	else
+	{
+		std::this_thread::sleep_for(std::chrono::microseconds(us));
+	}
+}
+
+void yield()
+{
+	std::this_thread::yield();
+}
+
+//------------------------------------------------------------------------------
+
+long random(long howbig)
+{
+	if (howbig == 0)
+	{
+		return 0;
+	}
+
+	// Park-Miller "minimal standard" generator, as in avr-libc.
+	long x = long(nextRandom);
+	if (x == 0)
+	{
+		x = 123459876L;
+	}
+	const long hi = x / 127773L;
+	const long lo = x % 127773L;
+	x = 16807L * lo - 2836L * hi;
+	if (x < 0)
+	{
+		x += 0x7fffffffL;
+	}
+	nextRandom = (unsigned long)x;
+
+	return (x % 0x80000000L) % howbig;
+}
+
+long random(long howsmall, long howbig)
+{
+	if (howsmall >= howbig)
+	{
+		return howsmall;
+	}
+	return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed)
+{
+	if (seed != 0)
+	{
+		nextRandom = seed;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+	if (isValidPin(pin))
+	{
+		pinModes[pin] = mode;
+	}
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+	if (isValidPin(pin))
+	{
+		digitalOutputs[pin] = (val != LOW);
+	}
+}
+
+int digitalRead(uint8_t pin)
+{
+	if (!isValidPin(pin))
+	{
+		return LOW;
+	}
+	if (digitalInputsSet[pin])
+	{
+		return digitalInputs[pin] ? HIGH : LOW;
+	}
+	return (pinModes[pin] == INPUT_PULLUP) ? HIGH : LOW;
+}
+
+int analogRead(uint8_t pin)
+{
+	pin = analogPin(pin);
+	return isValidPin(pin) ? analogInputs[pin] : 0;
+}
+
+void analogReference(uint8_t mode)
 {
-	std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+	(void)mode;
+}
+
+void analogWrite(uint8_t pin, int val)
+{
+	digitalWrite(pin, (val >= 128) ? HIGH : LOW);
 }
 
 //------------------------------------------------------------------------------
 
-int32_t random(int32_t max)
+void ArduinoEmu::setAnalogInput(uint8_t pin, uint16_t value)
 {
-	return std::rand() % max;
+	pin = analogPin(pin);
+	if (isValidPin(pin))
+	{
+		analogInputs[pin] = (value > 1023) ? 1023 : value;
+	}
+}
+
+void ArduinoEmu::setDigitalInput(uint8_t pin, bool level)
+{
+	if (isValidPin(pin))
+	{
+		digitalInputs[pin] = level;
+		digitalInputsSet[pin] = true;
+	}
+}
+
+bool ArduinoEmu::getDigitalOutput(uint8_t pin)
+{
+	return isValidPin(pin) ? digitalOutputs[pin] : false;
+}
+
+void ArduinoEmu::enableSimulatedClock(uint64_t startMicros)
+{
+	simulatedMicros = startMicros;
+	useSimulatedClock = true;
+}
+
+void ArduinoEmu::disableSimulatedClock()
+{
+	useSimulatedClock = false;
+}
+
+bool ArduinoEmu::isSimulatedClock()
+{
+	return useSimulatedClock;
+}
+
+void ArduinoEmu::advanceSimulatedClock(uint32_t us)
+{
+	simulatedMicros += us;
+}
+
+uint64_t ArduinoEmu::getSimulatedMicros()
+{
+	return simulatedMicros;
 }
 
 //------------------------------------------------------------------------------
 
-int32_t random(int32_t min, int32_t max)
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+	size_t n = 0;
+	while (size--)
+	{
+		n += write(*buffer++);
+	}
+	return n;
+}
+
+size_t Print::print(long n, int base)
+{
+	if (base == DEC && n < 0)
+	{
+		return print('-') + printNumber(0UL - (unsigned long)n, DEC);
+	}
+	return printNumber((unsigned long)n, base);
+}
+
+size_t Print::print(unsigned long n, int base)
+{
+	return printNumber(n, base);
+}
+
+size_t Print::print(double n, int digits)
 {
-	return random(max - min) + min;
+	char buffer[64];
+	const int len = snprintf(buffer, sizeof(buffer), "%.*f", digits, n);
+	return (len > 0) ? write(buffer) : 0;
+}
+
+size_t Print::printNumber(unsigned long n, uint8_t base)
+{
+	char buffer[8 * sizeof(long) + 1];
+	char *str = &buffer[sizeof(buffer) - 1];
+	*str = '\0';
+
+	if (base < 2)
+	{
+		base = 10;
+	}
+
+	do
+	{
+		const char c = char(n % base);
+		n /= base;
+		*--str = (c < 10) ? c + '0' : c + 'A' - 10;
+	} while (n);
+
+	return write(str);
 }
 
 //------------------------------------------------------------------------------
 
-void randomSeed(uint32_t seed)
+HardwareSerial Serial;
+
+void HardwareSerial::flush()
+{
+	fflush(stdout);
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+	return (fputc(c, stdout) == EOF) ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size)
 {
-	std::srand(seed);
+	return fwrite(buffer, 1, size, stdout);
 }
 
 //------------------------------------------------------------------------------
@@ -1,4 +1,3 @@
-
 /*******************************************************************************
 
 MIT License
@@ -25,42 +24,1484 @@ SOFTWARE.
 
 *******************************************************************************/
 
-#pragma message("Using FastLED Emulation on PC")
 #include "../FastLED.h"
 
-#define _USE_MATH_DEFINES
+//------------------------------------------------------------------------------
+// lib8tion
+//------------------------------------------------------------------------------
 
-#include <cmath>
-#include <limits>
+#define RAND16_SEED 1337
+uint16_t rand16seed = RAND16_SEED;
 
 //------------------------------------------------------------------------------
 
-int16_t sin16(uint16_t x)
+uint32_t emuOpCounts[EmuOp_COUNT] = {};
+
+const char *emuOpName(EEmuOp op)
 {
-	double x_d = (x * 2.0 * M_PI) / std::numeric_limits<uint16_t>::max();
-	double tmp = std::sin(x_d);
-	return int16_t(tmp * std::numeric_limits<int16_t>::max());
+	static const char *const names[EmuOp_COUNT] = {"hsv2rgb", "inoise8", "inoise16", "ColorFromPalette",
+												   "random8", "random16", "blur1d", "float_mul", "float_div"};
+	return (op < EmuOp_COUNT) ? names[op] : "?";
 }
 
 //------------------------------------------------------------------------------
 
-int8_t sin8(uint8_t x)
+uint8_t sin8(uint8_t theta)
 {
-	double x_d = (x * 2.0 * M_PI) / std::numeric_limits<uint8_t>::max();
-	double tmp = std::sin(x_d);
-	return int8_t(tmp * std::numeric_limits<int8_t>::max());
+	static const uint8_t b_m16_interleave[] = {0, 49, 49, 41, 90, 27, 117, 10};
+
+	uint8_t offset = theta;
+	if (theta & 0x40)
+	{
+		offset = uint8_t(255 - offset);
+	}
+	offset &= 0x3F; // 0..63
+
+	uint8_t secoffset = offset & 0x0F; // 0..15
+	if (theta & 0x40)
+	{
+		++secoffset;
+	}
+
+	const uint8_t section = offset >> 4; // 0..3
+	const uint8_t b = b_m16_interleave[section * 2];
+	const uint8_t m16 = b_m16_interleave[section * 2 + 1];
+
+	const uint8_t mx = uint8_t((m16 * secoffset) >> 4);
+
+	int8_t y = int8_t(mx + b);
+	if (theta & 0x80)
+	{
+		y = int8_t(-y);
+	}
+
+	return uint8_t(y + 128);
 }
 
 //------------------------------------------------------------------------------
 
-#define RAND16_SEED 1337
-uint16_t rand16seed = RAND16_SEED;
+int16_t sin16(uint16_t theta)
+{
+	static const uint16_t base[] = {0, 6393, 12539, 18204, 23170, 27245, 30273, 32137};
+	static const uint8_t slope[] = {49, 48, 44, 38, 31, 23, 14, 4};
+
+	uint16_t offset = (theta & 0x3FFF) >> 3; // 0..2047
+	if (theta & 0x4000)
+	{
+		offset = uint16_t(2047 - offset);
+	}
+
+	const uint8_t section = uint8_t(offset / 256); // 0..7
+	const uint16_t b = base[section];
+	const uint8_t m = slope[section];
+
+	const uint8_t secoffset8 = uint8_t(uint8_t(offset) / 2);
+	const uint16_t mx = uint16_t(m * secoffset8);
+
+	int16_t y = int16_t(mx + b);
+	if (theta & 0x8000)
+	{
+		y = int16_t(-y);
+	}
+
+	return y;
+}
+
+//------------------------------------------------------------------------------
+
+uint16_t sqrt16(uint16_t x)
+{
+	if (x <= 1)
+	{
+		return x;
+	}
+
+	uint8_t low = 1; // lower bound
+	uint8_t hi, mid;
+
+	if (x > 7904)
+	{
+		hi = 255;
+	}
+	else
+	{
+		hi = uint8_t((x >> 5) + 8); // initial estimate for upper bound
+	}
+
+	do
+	{
+		mid = uint8_t((low + hi) >> 1);
+		if (uint16_t(mid * mid) > x)
+		{
+			hi = uint8_t(mid - 1);
+		}
+		else
+		{
+			if (mid == 255)
+			{
+				return 255;
+			}
+			low = uint8_t(mid + 1);
+		}
+	} while (hi >= low);
+
+	return uint8_t(low - 1);
+}
+
+//------------------------------------------------------------------------------
+// hsv2rgb
+//------------------------------------------------------------------------------
+
+void hsv2rgb_rainbow(const CHSV &hsv, CRGB &rgb)
+{
+	emuCountOp(EmuOp_HSV2RGB);
+
+	const uint8_t K255 = 255;
+	const uint8_t K171 = 171;
+	const uint8_t K170 = 170;
+	const uint8_t K85 = 85;
+
+	const uint8_t hue = hsv.hue;
+	const uint8_t sat = hsv.sat;
+	uint8_t val = hsv.val;
+
+	const uint8_t offset = hue & 0x1F; // 0..31
+	const uint8_t offset8 = uint8_t(offset << 3);
+	const uint8_t third = scale8(offset8, (256 / 3)); // max = 85
+
+	uint8_t r, g, b;
+
+	if (!(hue & 0x80))
+	{
+		if (!(hue & 0x40))
+		{
+			if (!(hue & 0x20))
+			{
+				// case 0: R -> O
+				r = K255 - third;
+				g = third;
+				b = 0;
+			}
+			else
+			{
+				// case 1: O -> Y
+				r = K171;
+				g = K85 + third;
+				b = 0;
+			}
+		}
+		else
+		{
+			if (!(hue & 0x20))
+			{
+				// case 2: Y -> G
+				const uint8_t twothirds = scale8(offset8, ((256 * 2) / 3)); // max = 170
+				r = K171 - twothirds;
+				g = K170 + third;
+				b = 0;
+			}
+			else
+			{
+				// case 3: G -> A
+				r = 0;
+				g = K255 - third;
+				b = third;
+			}
+		}
+	}
+	else
+	{
+		if (!(hue & 0x40))
+		{
+			if (!(hue & 0x20))
+			{
+				// case 4: A -> B
+				const uint8_t twothirds = scale8(offset8, ((256 * 2) / 3)); // max = 170
+				r = 0;
+				g = K171 - twothirds;
+				b = K85 + twothirds;
+			}
+			else
+			{
+				// case 5: B -> P
+				r = third;
+				g = 0;
+				b = K255 - third;
+			}
+		}
+		else
+		{
+			if (!(hue & 0x20))
+			{
+				// case 6: P -- K
+				r = K85 + third;
+				g = 0;
+				b = K171 - third;
+			}
+			else
+			{
+				// case 7: K -> R
+				r = K170 + third;
+				g = 0;
+				b = K85 - third;
+			}
+		}
+	}
+
+	// Scale down colors if we're desaturated at all
+	// and add the brightness_floor to r, g, and b.
+	if (sat != 255)
+	{
+		if (sat == 0)
+		{
+			r = 255;
+			b = 255;
+			g = 255;
+		}
+		else
+		{
+			uint8_t desat = 255 - sat;
+			desat = scale8_video(desat, desat);
+			const uint8_t satscale = 255 - desat;
+
+			if (r)
+				r = scale8(r, satscale) + 1;
+			if (g)
+				g = scale8(g, satscale) + 1;
+			if (b)
+				b = scale8(b, satscale) + 1;
+
+			const uint8_t brightness_floor = desat;
+			r += brightness_floor;
+			g += brightness_floor;
+			b += brightness_floor;
+		}
+	}
+
+	// Now scale everything down if we're at value < 255.
+	if (val != 255)
+	{
+		val = scale8_video(val, val);
+		if (val == 0)
+		{
+			r = 0;
+			g = 0;
+			b = 0;
+		}
+		else
+		{
+			if (r)
+				r = scale8(r, val) + 1;
+			if (g)
+				g = scale8(g, val) + 1;
+			if (b)
+				b = scale8(b, val) + 1;
+		}
+	}
+
+	rgb.r = r;
+	rgb.g = g;
+	rgb.b = b;
+}
+
+void hsv2rgb_rainbow(const CHSV *phsv, CRGB *prgb, int numLeds)
+{
+	for (int i = 0; i < numLeds; ++i)
+	{
+		hsv2rgb_rainbow(phsv[i], prgb[i]);
+	}
+}
+
+//------------------------------------------------------------------------------
+
+void hsv2rgb_raw(const CHSV &hsv, CRGB &rgb)
+{
+	emuCountOp(EmuOp_HSV2RGB);
+
+	const uint8_t HSV_SECTION_3 = 0x40;
+
+	// Convert hue, saturation and brightness ( HSV/HSB ) to RGB
+	const uint8_t value = hsv.val;
+	const uint8_t saturation = hsv.sat;
+
+	// The brightness floor is minimum number that all of R, G, and B will be set to.
+	const uint8_t invsat = 255 - saturation;
+	const uint8_t brightness_floor = uint8_t((value * invsat) / 256);
+
+	// The color amplitude is the maximum amount of R, G, and B that will be added on top of the brightness_floor
+	const uint8_t color_amplitude = value - brightness_floor;
+
+	// Figure out which section of the hue wheel we're in, and how far offset we are withing that section
+	const uint8_t section = hsv.hue / HSV_SECTION_3;  // 0..2
+	const uint8_t offset = hsv.hue % HSV_SECTION_3; // 0..63
+
+	const uint8_t rampup = offset;
+	const uint8_t rampdown = (HSV_SECTION_3 - 1) - offset;
+
+	// compute color-amplitude-scaled-down versions of rampup and rampdown
+	const uint8_t rampup_amp_adj = uint8_t((rampup * color_amplitude) / (256 / 4));
+	const uint8_t rampdown_amp_adj = uint8_t((rampdown * color_amplitude) / (256 / 4));
+
+	// add brightness_floor offset to everything
+	const uint8_t rampup_adj_with_floor = rampup_amp_adj + brightness_floor;
+	const uint8_t rampdown_adj_with_floor = rampdown_amp_adj + brightness_floor;
+
+	if (section)
+	{
+		if (section == 1)
+		{
+			// section 1: 0x40..0x7F
+			rgb.r = brightness_floor;
+			rgb.g = rampdown_adj_with_floor;
+			rgb.b = rampup_adj_with_floor;
+		}
+		else
+		{
+			// section 2; 0x80..0xBF
+			rgb.r = rampup_adj_with_floor;
+			rgb.g = brightness_floor;
+			rgb.b = rampdown_adj_with_floor;
+		}
+	}
+	else
+	{
+		// section 0: 0x00..0x3F
+		rgb.r = rampdown_adj_with_floor;
+		rgb.g = rampup_adj_with_floor;
+		rgb.b = brightness_floor;
+	}
+}
+
+void hsv2rgb_spectrum(const CHSV &hsv, CRGB &rgb)
+{
+	CHSV hsv2(hsv);
+	hsv2.hue = scale8(hsv2.hue, 191);
+	hsv2rgb_raw(hsv2, rgb);
+}
+
+//------------------------------------------------------------------------------
+
+CHSV rgb2hsv_approximate(const CRGB &rgb)
+{
+	uint8_t r = rgb.r;
+	uint8_t g = rgb.g;
+	uint8_t b = rgb.b;
+	uint8_t h, s, v;
+
+	// find desaturation
+	uint8_t desat = 255;
+	if (r < desat)
+		desat = r;
+	if (g < desat)
+		desat = g;
+	if (b < desat)
+		desat = b;
+
+	// remove saturation from all channels
+	r -= desat;
+	g -= desat;
+	b -= desat;
+
+	// saturation is opposite of desaturation
+	s = 255 - desat;
+
+	if (s != 255)
+	{
+		// undo 'dimming' of saturation
+		s = 255 - sqrt16(uint16_t((255 - s) * 256));
+	}
+
+	// at least one channel is now zero
+	// if all three channels are zero, we had a shade of gray.
+	if ((r + g + b) == 0)
+	{
+		return CHSV(0, 0, 255 - s);
+	}
+
+	// scale all channels up to compensate for desaturation
+	if (s < 255)
+	{
+		if (s == 0)
+			s = 1;
+		const uint32_t scaleup = 65535 / s;
+		r = uint8_t((r * scaleup) / 256);
+		g = uint8_t((g * scaleup) / 256);
+		b = uint8_t((b * scaleup) / 256);
+	}
+
+	const uint16_t total = r + g + b;
+
+	// scale all channels up to compensate for low values
+	if (total < 255)
+	{
+		if (total == 0)
+			return CHSV(0, 0, 0);
+		const uint32_t scaleup = 65535 / total;
+		r = uint8_t((r * scaleup) / 256);
+		g = uint8_t((g * scaleup) / 256);
+		b = uint8_t((b * scaleup) / 256);
+	}
+
+	if (total > 255)
+	{
+		v = 255;
+	}
+	else
+	{
+		v = qadd8(desat, uint8_t(total));
+		// undo 'dimming' of brightness
+		if (v != 255)
+			v = uint8_t(sqrt16(uint16_t(v * 256)));
+	}
+
+	const uint8_t highest = (r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b);
+
+	if (highest == r)
+	{
+		// Red is highest; Hue could be Purple/Pink-Red,Red-Orange,Orange-Yellow
+		if (g == 0)
+		{
+			// if green is zero, we're in Purple/Pink-Red
+			h = uint8_t((HUE_PURPLE + HUE_PINK) / 2);
+			h += scale8(qsub8(r, 128), 48);
+		}
+		else if ((r - g) > g)
+		{
+			// if R-G > G then we're in Red-Orange
+			h = HUE_RED;
+			h += scale8(g, 42);
+		}
+		else
+		{
+			// R-G < G, we're in Orange-Yellow
+			h = HUE_ORANGE;
+			h += scale8(qsub8((g - 85) + (171 - r), 4), 42);
+		}
+	}
+	else if (highest == g)
+	{
+		// Green is highest; Hue could be Yellow-Green, Green-Aqua
+		if (b == 0)
+		{
+			// if Blue is zero, we're in Yellow-Green
+			h = HUE_YELLOW;
+			h += scale8(qadd8(qadd8(g, g), g), 42);
+		}
+		else
+		{
+			// if Blue is nonzero we're in Green-Aqua
+			if ((g - b) > b)
+			{
+				h = HUE_GREEN;
+				h += scale8(b, 85);
+			}
+			else
+			{
+				h = HUE_AQUA;
+				h += scale8(qsub8(b, 85), 170);
+			}
+		}
+	}
+	else
+	{
+		// Blue is highest; Hue could be Aqua/Blue-Blue, Blue-Purple, Purple-Pink
+		if (r == 0)
+		{
+			// if red is zero, we're in Aqua/Blue-Blue
+			h = HUE_AQUA + ((HUE_BLUE - HUE_AQUA) / 4);
+			h += scale8(qsub8(b, 128), 24);
+		}
+		else if ((b - r) > r)
+		{
+			// B-R > R, we're in Blue-Purple
+			h = HUE_BLUE;
+			h += scale8(r, 85);
+		}
+		else
+		{
+			// B-R < R, we're in Purple-Pink
+			h = HUE_PURPLE;
+			h += scale8(qsub8(r, 85), 85);
+		}
+	}
+
+	h += 1;
+	return CHSV(h, s, v);
+}
+
+//------------------------------------------------------------------------------
+// colorutils
+//------------------------------------------------------------------------------
+
+const TProgmemRGBPalette16 CloudColors_p = {
+	CRGB::Blue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue,
+	CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue,
+	CRGB::Blue, CRGB::DarkBlue, CRGB::SkyBlue, CRGB::SkyBlue,
+	CRGB::LightBlue, CRGB::White, CRGB::LightBlue, CRGB::SkyBlue};
+
+const TProgmemRGBPalette16 LavaColors_p = {
+	CRGB::Black, CRGB::Maroon, CRGB::Black, CRGB::Maroon,
+	CRGB::DarkRed, CRGB::DarkRed, CRGB::Maroon, CRGB::DarkRed,
+	CRGB::DarkRed, CRGB::DarkRed, CRGB::Red, CRGB::Orange,
+	CRGB::White, CRGB::Orange, CRGB::Red, CRGB::DarkRed};
+
+const TProgmemRGBPalette16 OceanColors_p = {
+	CRGB::MidnightBlue, CRGB::DarkBlue, CRGB::MidnightBlue, CRGB::Navy,
+	CRGB::DarkBlue, CRGB::MediumBlue, CRGB::SeaGreen, CRGB::Teal,
+	CRGB::CadetBlue, CRGB::Blue, CRGB::DarkCyan, CRGB::CornflowerBlue,
+	CRGB::Aquamarine, CRGB::SeaGreen, CRGB::Aqua, CRGB::LightSkyBlue};
+
+const TProgmemRGBPalette16 ForestColors_p = {
+	CRGB::DarkGreen, CRGB::DarkGreen, CRGB::DarkOliveGreen, CRGB::DarkGreen,
+	CRGB::Green, CRGB::ForestGreen, CRGB::OliveDrab, CRGB::Green,
+	CRGB::SeaGreen, CRGB::MediumAquamarine, CRGB::LimeGreen, CRGB::YellowGreen,
+	CRGB::LightGreen, CRGB::LawnGreen, CRGB::MediumAquamarine, CRGB::ForestGreen};
+
+const TProgmemRGBPalette16 RainbowColors_p = {
+	0xFF0000, 0xD52A00, 0xAB5500, 0xAB7F00,
+	0xABAB00, 0x56D500, 0x00FF00, 0x00D52A,
+	0x00AB55, 0x0056AA, 0x0000FF, 0x2A00D5,
+	0x5500AB, 0x7F0081, 0xAB0055, 0xD5002B};
+
+const TProgmemRGBPalette16 RainbowStripeColors_p = {
+	0xFF0000, 0x000000, 0xAB5500, 0x000000,
+	0xABAB00, 0x000000, 0x00FF00, 0x000000,
+	0x00AB55, 0x000000, 0x0000FF, 0x000000,
+	0x5500AB, 0x000000, 0xAB0055, 0x000000};
+
+const TProgmemRGBPalette16 PartyColors_p = {
+	0x5500AB, 0x84007C, 0xB5004B, 0xE5001B,
+	0xE81700, 0xB84700, 0xAB7700, 0xABAB00,
+	0xAB5500, 0xDD2200, 0xF2000E, 0xC2003E,
+	0x8F0071, 0x5F00A1, 0x2F00D0, 0x0007F9};
+
+const TProgmemRGBPalette16 HeatColors_p = {
+	0x000000,
+	0x330000, 0x660000, 0x990000, 0xCC0000, 0xFF0000,
+	0xFF3300, 0xFF6600, 0xFF9900, 0xFFCC00, 0xFFFF00,
+	0xFFFF33, 0xFFFF66, 0xFFFF99, 0xFFFFCC, 0xFFFFFF};
+
+//------------------------------------------------------------------------------
+
+CRGBPalette16::CRGBPalette16(const TProgmemRGBPalette16 &rhs)
+{
+	for (uint8_t i = 0; i < 16; ++i)
+	{
+		entries[i] = rhs[i];
+	}
+}
+
+CRGBPalette16::CRGBPalette16(const CRGB &c1)
+{
+	fill_solid(entries, 16, c1);
+}
+
+CRGBPalette16::CRGBPalette16(const CRGB &c1, const CRGB &c2)
+{
+	fill_gradient_RGB(entries, 16, c1, c2);
+}
+
+CRGBPalette16::CRGBPalette16(const CRGB &c1, const CRGB &c2, const CRGB &c3)
+{
+	fill_gradient_RGB(entries, 16, c1, c2, c3);
+}
+
+CRGBPalette16::CRGBPalette16(const CRGB &c1, const CRGB &c2, const CRGB &c3, const CRGB &c4)
+{
+	fill_gradient_RGB(entries, 16, c1, c2, c3, c4);
+}
+
+bool CRGBPalette16::operator==(const CRGBPalette16 &rhs) const
+{
+	for (uint8_t i = 0; i < 16; ++i)
+	{
+		if (entries[i] != rhs.entries[i])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------
+
+CRGB ColorFromPalette(const CRGBPalette16 &pal, uint8_t index, uint8_t brightness, TBlendType blendType)
+{
+	emuCountOp(EmuOp_ColorFromPalette);
+
+	if (blendType == LINEARBLEND_NOWRAP)
+	{
+		index = map8(index, 0, 239);
+	}
+
+	const uint8_t hi4 = index >> 4;
+	const uint8_t lo4 = index & 0x0F;
+
+	const CRGB *entry = &(pal[0]) + hi4;
+
+	uint8_t red1 = entry->red;
+	uint8_t green1 = entry->green;
+	uint8_t blue1 = entry->blue;
+
+	const bool blend = lo4 && (blendType != NOBLEND);
+	if (blend)
+	{
+		if (hi4 == 15)
+		{
+			entry = &(pal[0]);
+		}
+		else
+		{
+			++entry;
+		}
+
+		const uint8_t f2 = uint8_t(lo4 << 4);
+		const uint8_t f1 = 255 - f2;
+
+		red1 = scale8(red1, f1) + scale8(entry->red, f2);
+		green1 = scale8(green1, f1) + scale8(entry->green, f2);
+		blue1 = scale8(blue1, f1) + scale8(entry->blue, f2);
+	}
+
+	if (brightness != 255)
+	{
+		if (brightness)
+		{
+			++brightness; // adjust for rounding
+			if (red1)
+				red1 = scale8(red1, brightness);
+			if (green1)
+				green1 = scale8(green1, brightness);
+			if (blue1)
+				blue1 = scale8(blue1, brightness);
+		}
+		else
+		{
+			red1 = 0;
+			green1 = 0;
+			blue1 = 0;
+		}
+	}
+
+	return CRGB(red1, green1, blue1);
+}
+
+//------------------------------------------------------------------------------
+
+CRGB HeatColor(uint8_t temperature)
+{
+	CRGB heatcolor;
+
+	// Scale 'heat' down from 0-255 to 0-191,
+	// which can then be easily divided into three
+	// equal 'thirds' of 64 units each.
+	const uint8_t t192 = scale8_video(temperature, 191);
+
+	// calculate a value that ramps up from
+	// zero to 255 in each 'third' of the scale.
+	const uint8_t heatramp = uint8_t((t192 & 0x3F) << 2);
+
+	if (t192 & 0x80)
+	{
+		// we're in the hottest third
+		heatcolor.r = 255;
+		heatcolor.g = 255;
+		heatcolor.b = heatramp;
+	}
+	else if (t192 & 0x40)
+	{
+		// we're in the middle third
+		heatcolor.r = 255;
+		heatcolor.g = heatramp;
+		heatcolor.b = 0;
+	}
+	else
+	{
+		// we're in the coolest third
+		heatcolor.r = heatramp;
+		heatcolor.g = 0;
+		heatcolor.b = 0;
+	}
+
+	return heatcolor;
+}
+
+//------------------------------------------------------------------------------
+
+void fill_solid(CRGB *leds, int numToFill, const CRGB &color)
+{
+	for (int i = 0; i < numToFill; ++i)
+	{
+		leds[i] = color;
+	}
+}
+
+void fill_solid(CHSV *targetArray, int numToFill, const CHSV &color)
+{
+	for (int i = 0; i < numToFill; ++i)
+	{
+		targetArray[i] = color;
+	}
+}
+
+void fill_rainbow(CRGB *targetArray, int numToFill, uint8_t initialhue, uint8_t deltahue)
+{
+	CHSV hsv;
+	hsv.hue = initialhue;
+	hsv.val = 255;
+	hsv.sat = 240;
+	for (int i = 0; i < numToFill; ++i)
+	{
+		targetArray[i] = hsv;
+		hsv.hue += deltahue;
+	}
+}
+
+void fill_gradient_RGB(CRGB *leds, uint16_t startpos, CRGB startcolor, uint16_t endpos, CRGB endcolor)
+{
+	// if the points are in the wrong order, straighten them
+	if (endpos < startpos)
+	{
+		const uint16_t t = endpos;
+		const CRGB tc = endcolor;
+		endcolor = startcolor;
+		endpos = startpos;
+		startpos = t;
+		startcolor = tc;
+	}
+
+	saccum87 rdistance87 = saccum87((endcolor.r - startcolor.r) << 7);
+	saccum87 gdistance87 = saccum87((endcolor.g - startcolor.g) << 7);
+	saccum87 bdistance87 = saccum87((endcolor.b - startcolor.b) << 7);
+
+	const uint16_t pixeldistance = endpos - startpos;
+	const int16_t divisor = pixeldistance ? pixeldistance : 1;
+
+	saccum87 rdelta87 = rdistance87 / divisor;
+	saccum87 gdelta87 = gdistance87 / divisor;
+	saccum87 bdelta87 = bdistance87 / divisor;
+
+	rdelta87 *= 2;
+	gdelta87 *= 2;
+	bdelta87 *= 2;
+
+	accum88 r88 = accum88(startcolor.r << 8);
+	accum88 g88 = accum88(startcolor.g << 8);
+	accum88 b88 = accum88(startcolor.b << 8);
+	for (uint16_t i = startpos; i <= endpos; ++i)
+	{
+		leds[i] = CRGB(r88 >> 8, g88 >> 8, b88 >> 8);
+		r88 += rdelta87;
+		g88 += gdelta87;
+		b88 += bdelta87;
+	}
+}
+
+void fill_gradient_RGB(CRGB *leds, uint16_t numLeds, const CRGB &c1, const CRGB &c2)
+{
+	const uint16_t last = numLeds - 1;
+	fill_gradient_RGB(leds, 0, c1, last, c2);
+}
+
+void fill_gradient_RGB(CRGB *leds, uint16_t numLeds, const CRGB &c1, const CRGB &c2, const CRGB &c3)
+{
+	const uint16_t half = (numLeds / 2);
+	const uint16_t last = numLeds - 1;
+	fill_gradient_RGB(leds, 0, c1, half, c2);
+	fill_gradient_RGB(leds, half, c2, last, c3);
+}
+
+void fill_gradient_RGB(CRGB *leds, uint16_t numLeds, const CRGB &c1, const CRGB &c2, const CRGB &c3, const CRGB &c4)
+{
+	const uint16_t onethird = (numLeds / 3);
+	const uint16_t twothirds = ((numLeds * 2) / 3);
+	const uint16_t last = numLeds - 1;
+	fill_gradient_RGB(leds, 0, c1, onethird, c2);
+	fill_gradient_RGB(leds, onethird, c2, twothirds, c3);
+	fill_gradient_RGB(leds, twothirds, c3, last, c4);
+}
+
+void fill_palette(CRGB *L, uint16_t N, uint8_t startIndex, uint8_t incIndex,
+				  const CRGBPalette16 &pal, uint8_t brightness, TBlendType blendType)
+{
+	uint8_t colorIndex = startIndex;
+	for (uint16_t i = 0; i < N; ++i)
+	{
+		L[i] = ColorFromPalette(pal, colorIndex, brightness, blendType);
+		colorIndex += incIndex;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+void nscale8_video(CRGB *leds, uint16_t num_leds, uint8_t scale)
+{
+	for (uint16_t i = 0; i < num_leds; ++i)
+	{
+		leds[i].nscale8_video(scale);
+	}
+}
+
+void nscale8(CRGB *leds, uint16_t num_leds, uint8_t scale)
+{
+	for (uint16_t i = 0; i < num_leds; ++i)
+	{
+		leds[i].nscale8(scale);
+	}
+}
+
+void fadeLightBy(CRGB *leds, uint16_t num_leds, uint8_t fadeBy)
+{
+	nscale8_video(leds, num_leds, 255 - fadeBy);
+}
+
+void fadeToBlackBy(CRGB *leds, uint16_t num_leds, uint8_t fadeBy)
+{
+	nscale8(leds, num_leds, 255 - fadeBy);
+}
+
+void fade_video(CRGB *leds, uint16_t num_leds, uint8_t fadeBy)
+{
+	nscale8_video(leds, num_leds, 255 - fadeBy);
+}
+
+void fade_raw(CRGB *leds, uint16_t num_leds, uint8_t fadeBy)
+{
+	nscale8(leds, num_leds, 255 - fadeBy);
+}
+
+void fadeUsingColor(CRGB *leds, uint16_t numLeds, const CRGB &colormask)
+{
+	for (uint16_t i = 0; i < numLeds; ++i)
+	{
+		leds[i].nscale8(colormask);
+	}
+}
+
+//------------------------------------------------------------------------------
+
+CRGB &nblend(CRGB &existing, const CRGB &overlay, fract8 amountOfOverlay)
+{
+	if (amountOfOverlay == 0)
+	{
+		return existing;
+	}
+
+	if (amountOfOverlay == 255)
+	{
+		existing = overlay;
+		return existing;
+	}
+
+	existing.red = blend8(existing.red, overlay.red, amountOfOverlay);
+	existing.green = blend8(existing.green, overlay.green, amountOfOverlay);
+	existing.blue = blend8(existing.blue, overlay.blue, amountOfOverlay);
+
+	return existing;
+}
+
+void nblend(CRGB *existing, CRGB *overlay, uint16_t count, fract8 amountOfOverlay)
+{
+	for (uint16_t i = 0; i < count; ++i)
+	{
+		nblend(existing[i], overlay[i], amountOfOverlay);
+	}
+}
+
+CRGB blend(const CRGB &p1, const CRGB &p2, fract8 amountOfP2)
+{
+	CRGB nu(p1);
+	nblend(nu, p2, amountOfP2);
+	return nu;
+}
+
+//------------------------------------------------------------------------------
+
+void blur1d(CRGB *leds, uint16_t numLeds, fract8 blur_amount)
+{
+	emuCountOp(EmuOp_blur1d);
+
+	const uint8_t keep = 255 - blur_amount;
+	const uint8_t seep = blur_amount >> 1;
+	CRGB carryover = CRGB::Black;
+	for (uint16_t i = 0; i < numLeds; ++i)
+	{
+		CRGB cur = leds[i];
+		CRGB part = cur;
+		part.nscale8(seep);
+		cur.nscale8(keep);
+		cur += carryover;
+		if (i)
+		{
+			leds[i - 1] += part;
+		}
+		leds[i] = cur;
+		carryover = part;
+	}
+}
+
+//------------------------------------------------------------------------------
+// noise
+//------------------------------------------------------------------------------
+
+namespace
+{
+	// Ken Perlin's permutation table, with the first entry repeated at the end.
+	const uint8_t p[] = {
+		151, 160, 137, 91, 90, 15, 131, 13, 201, 95, 96, 53, 194, 233, 7, 225,
+		140, 36, 103, 30, 69, 142, 8, 99, 37, 240, 21, 10, 23, 190, 6, 148,
+		247, 120, 234, 75, 0, 26, 197, 62, 94, 252, 219, 203, 117, 35, 11, 32,
+		57, 177, 33, 88, 237, 149, 56, 87, 174, 20, 125, 136, 171, 168, 68, 175,
+		74, 165, 71, 134, 139, 48, 27, 166, 77, 146, 158, 231, 83, 111, 229, 122,
+		60, 211, 133, 230, 220, 105, 92, 41, 55, 46, 245, 40, 244, 102, 143, 54,
+		65, 25, 63, 161, 1, 216, 80, 73, 209, 76, 132, 187, 208, 89, 18, 169,
+		200, 196, 135, 130, 116, 188, 159, 86, 164, 100, 109, 198, 173, 186, 3, 64,
+		52, 217, 226, 250, 124, 123, 5, 202, 38, 147, 118, 126, 255, 82, 85, 212,
+		207, 206, 59, 227, 47, 16, 58, 17, 182, 189, 28, 42, 223, 183, 170, 213,
+		119, 248, 152, 2, 44, 154, 163, 70, 221, 153, 101, 155, 167, 43, 172, 9,
+		129, 22, 39, 253, 19, 98, 108, 110, 79, 113, 224, 232, 178, 185, 112, 104,
+		218, 246, 97, 228, 251, 34, 242, 193, 238, 210, 144, 12, 191, 179, 162, 241,
+		81, 51, 145, 235, 249, 14, 239, 107, 49, 192, 214, 31, 181, 199, 106, 157,
+		184, 84, 204, 176, 115, 121, 50, 45, 127, 4, 150, 254, 138, 236, 205, 93,
+		222, 114, 67, 29, 24, 72, 243, 141, 128, 195, 78, 66, 215, 61, 156, 180,
+		151};
+
+	inline uint8_t P(int x) { return p[x]; }
+
+	inline int16_t grad16(uint8_t hash, int16_t x, int16_t y, int16_t z)
+	{
+		hash = hash & 15;
+		int16_t u = hash < 8 ? x : y;
+		int16_t v = hash < 4 ? y : hash == 12 || hash == 14 ? x : z;
+		if (hash & 1)
+			u = int16_t(-u);
+		if (hash & 2)
+			v = int16_t(-v);
+		return int16_t((u + v) >> 1);
+	}
+
+	inline int16_t grad16(uint8_t hash, int16_t x, int16_t y)
+	{
+		hash = hash & 7;
+		int16_t u, v;
+		if (hash < 4)
+		{
+			u = x;
+			v = y;
+		}
+		else
+		{
+			u = y;
+			v = x;
+		}
+		if (hash & 1)
+			u = int16_t(-u);
+		if (hash & 2)
+			v = int16_t(-v);
+		return int16_t((u + v) >> 1);
+	}
+
+	inline int16_t grad16(uint8_t hash, int16_t x)
+	{
+		hash = hash & 15;
+		int16_t u, v;
+		if (hash > 8)
+		{
+			u = x;
+			v = x;
+		}
+		else if (hash < 4)
+		{
+			u = x;
+			v = 1;
+		}
+		else
+		{
+			u = 1;
+			v = x;
+		}
+		if (hash & 1)
+			u = int16_t(-u);
+		if (hash & 2)
+			v = int16_t(-v);
+		return int16_t((u + v) >> 1);
+	}
+
+	inline int8_t grad8(uint8_t hash, int8_t x, int8_t y, int8_t z)
+	{
+		hash &= 0xF;
+		int8_t u = (hash & 8) ? y : x;
+		int8_t v = hash < 4 ? y : hash == 12 || hash == 14 ? x : z;
+		if (hash & 1)
+			u = int8_t(-u);
+		if (hash & 2)
+			v = int8_t(-v);
+		return avg7(u, v);
+	}
+
+	inline int8_t grad8(uint8_t hash, int8_t x, int8_t y)
+	{
+		int8_t u, v;
+		if (hash & 4)
+		{
+			u = y;
+			v = x;
+		}
+		else
+		{
+			u = x;
+			v = y;
+		}
+		if (hash & 1)
+			u = int8_t(-u);
+		if (hash & 2)
+			v = int8_t(-v);
+		return avg7(u, v);
+	}
+
+	inline int8_t grad8(uint8_t hash, int8_t x)
+	{
+		int8_t u, v;
+		if (hash & 8)
+		{
+			u = x;
+			v = x;
+		}
+		else if (hash & 4)
+		{
+			u = 1;
+			v = x;
+		}
+		else
+		{
+			u = x;
+			v = 1;
+		}
+		if (hash & 1)
+			u = int8_t(-u);
+		if (hash & 2)
+			v = int8_t(-v);
+		return avg7(u, v);
+	}
+
+	inline int8_t lerp7by8(int8_t a, int8_t b, fract8 frac)
+	{
+		if (b > a)
+		{
+			const uint8_t delta = uint8_t(b - a);
+			return int8_t(a + scale8(delta, frac));
+		}
+		const uint8_t delta = uint8_t(a - b);
+		return int8_t(a - scale8(delta, frac));
+	}
+
+} // namespace
 
 //------------------------------------------------------------------------------
 
-#define asm
-#define volatile(x)
+int16_t inoise16_raw(uint32_t x, uint32_t y, uint32_t z)
+{
+	emuCountOp(EmuOp_inoise16);
+
+	// Find the unit cube containing the point
+	const uint8_t X = (x >> 16) & 0xFF;
+	const uint8_t Y = (y >> 16) & 0xFF;
+	const uint8_t Z = (z >> 16) & 0xFF;
+
+	// Hash cube corner coordinates
+	const uint8_t A = uint8_t(P(X) + Y);
+	const uint8_t AA = uint8_t(P(A) + Z);
+	const uint8_t AB = uint8_t(P(A + 1) + Z);
+	const uint8_t B = uint8_t(P(X + 1) + Y);
+	const uint8_t BA = uint8_t(P(B) + Z);
+	const uint8_t BB = uint8_t(P(B + 1) + Z);
+
+	// Get the relative position of the point in the cube
+	uint16_t u = x & 0xFFFF;
+	uint16_t v = y & 0xFFFF;
+	uint16_t w = z & 0xFFFF;
+
+	// Get a signed version of the above for the grad function
+	const int16_t xx = (u >> 1) & 0x7FFF;
+	const int16_t yy = (v >> 1) & 0x7FFF;
+	const int16_t zz = (w >> 1) & 0x7FFF;
+	const uint16_t N = 0x8000L;
+
+	u = ease16InOutQuad(u);
+	v = ease16InOutQuad(v);
+	w = ease16InOutQuad(w);
+
+	const int16_t X1 = lerp15by16(grad16(P(AA), xx, yy, zz), grad16(P(BA), xx - N, yy, zz), u);
+	const int16_t X2 = lerp15by16(grad16(P(AB), xx, yy - N, zz), grad16(P(BB), xx - N, yy - N, zz), u);
+	const int16_t X3 = lerp15by16(grad16(P(AA + 1), xx, yy, zz - N), grad16(P(BA + 1), xx - N, yy, zz - N), u);
+	const int16_t X4 = lerp15by16(grad16(P(AB + 1), xx, yy - N, zz - N), grad16(P(BB + 1), xx - N, yy - N, zz - N), u);
+
+	const int16_t Y1 = lerp15by16(X1, X2, v);
+	const int16_t Y2 = lerp15by16(X3, X4, v);
+
+	return lerp15by16(Y1, Y2, w);
+}
+
+uint16_t inoise16(uint32_t x, uint32_t y, uint32_t z)
+{
+	const int32_t ans = inoise16_raw(x, y, z) + 19052L;
+	const uint32_t pan = uint32_t(ans) * 440L;
+	return uint16_t(pan >> 8);
+}
+
+int16_t inoise16_raw(uint32_t x, uint32_t y)
+{
+	emuCountOp(EmuOp_inoise16);
+
+	// Find the unit cube containing the point
+	const uint8_t X = uint8_t(x >> 16);
+	const uint8_t Y = uint8_t(y >> 16);
+
+	// Hash cube corner coordinates
+	const uint8_t A = uint8_t(P(X) + Y);
+	const uint8_t AA = P(A);
+	const uint8_t AB = P(A + 1);
+	const uint8_t B = uint8_t(P(X + 1) + Y);
+	const uint8_t BA = P(B);
+	const uint8_t BB = P(B + 1);
+
+	// Get the relative position of the point in the cube
+	uint16_t u = x & 0xFFFF;
+	uint16_t v = y & 0xFFFF;
+
+	// Get a signed version of the above for the grad function
+	const int16_t xx = (u >> 1) & 0x7FFF;
+	const int16_t yy = (v >> 1) & 0x7FFF;
+	const uint16_t N = 0x8000L;
+
+	u = ease16InOutQuad(u);
+	v = ease16InOutQuad(v);
+
+	const int16_t X1 = lerp15by16(grad16(P(AA), xx, yy), grad16(P(BA), xx - N, yy), u);
+	const int16_t X2 = lerp15by16(grad16(P(AB), xx, yy - N), grad16(P(BB), xx - N, yy - N), u);
+
+	return lerp15by16(X1, X2, v);
+}
+
+uint16_t inoise16(uint32_t x, uint32_t y)
+{
+	const int32_t ans = inoise16_raw(x, y) + 17308L;
+	const uint32_t pan = uint32_t(ans) * 484L;
+	return uint16_t(pan >> 8);
+}
+
+int16_t inoise16_raw(uint32_t x)
+{
+	emuCountOp(EmuOp_inoise16);
+
+	// Find the unit cube containing the point
+	const uint8_t X = uint8_t(x >> 16);
+
+	// Hash cube corner coordinates
+	const uint8_t A = P(X);
+	const uint8_t AA = P(A);
+	const uint8_t B = P(X + 1);
+	const uint8_t BA = P(B);
+
+	// Get the relative position of the point in the cube
+	uint16_t u = x & 0xFFFF;
+
+	// Get a signed version of the above for the grad function
+	const int16_t xx = (u >> 1) & 0x7FFF;
+	const uint16_t N = 0x8000L;
+
+	u = ease16InOutQuad(u);
+
+	return lerp15by16(grad16(P(AA), xx), grad16(P(BA), xx - N), u);
+}
+
+uint16_t inoise16(uint32_t x)
+{
+	return uint16_t(uint32_t(int32_t(inoise16_raw(x)) + 17308L) << 1);
+}
+
+//------------------------------------------------------------------------------
+
+int8_t inoise8_raw(uint16_t x, uint16_t y, uint16_t z)
+{
+	emuCountOp(EmuOp_inoise8);
+
+	// Find the unit cube containing the point
+	const uint8_t X = uint8_t(x >> 8);
+	const uint8_t Y = uint8_t(y >> 8);
+	const uint8_t Z = uint8_t(z >> 8);
+
+	// Hash cube corner coordinates
+	const uint8_t A = uint8_t(P(X) + Y);
+	const uint8_t AA = uint8_t(P(A) + Z);
+	const uint8_t AB = uint8_t(P(A + 1) + Z);
+	const uint8_t B = uint8_t(P(X + 1) + Y);
+	const uint8_t BA = uint8_t(P(B) + Z);
+	const uint8_t BB = uint8_t(P(B + 1) + Z);
 
-#include "../../../../FastLED/hsv2rgb.cpp"
+	// Get the relative position of the point in the cube
+	uint8_t u = uint8_t(x);
+	uint8_t v = uint8_t(y);
+	uint8_t w = uint8_t(z);
+
+	// Get a signed version of the above for the grad function
+	const int8_t xx = (uint8_t(x) >> 1) & 0x7F;
+	const int8_t yy = (uint8_t(y) >> 1) & 0x7F;
+	const int8_t zz = (uint8_t(z) >> 1) & 0x7F;
+	const uint8_t N = 0x80;
+
+	u = ease8InOutQuad(u);
+	v = ease8InOutQuad(v);
+	w = ease8InOutQuad(w);
+
+	const int8_t X1 = lerp7by8(grad8(P(AA), xx, yy, zz), grad8(P(BA), xx - N, yy, zz), u);
+	const int8_t X2 = lerp7by8(grad8(P(AB), xx, yy - N, zz), grad8(P(BB), xx - N, yy - N, zz), u);
+	const int8_t X3 = lerp7by8(grad8(P(AA + 1), xx, yy, zz - N), grad8(P(BA + 1), xx - N, yy, zz - N), u);
+	const int8_t X4 = lerp7by8(grad8(P(AB + 1), xx, yy - N, zz - N), grad8(P(BB + 1), xx - N, yy - N, zz - N), u);
+
+	const int8_t Y1 = lerp7by8(X1, X2, v);
+	const int8_t Y2 = lerp7by8(X3, X4, v);
+
+	return lerp7by8(Y1, Y2, w);
+}
+
+uint8_t inoise8(uint16_t x, uint16_t y, uint16_t z)
+{
+	int8_t n = inoise8_raw(x, y, z); // -64..+64
+	n += 64;                         //   0..128
+	return qadd8(uint8_t(n), uint8_t(n)); // 0..255
+}
+
+int8_t inoise8_raw(uint16_t x, uint16_t y)
+{
+	emuCountOp(EmuOp_inoise8);
+
+	// Find the unit cube containing the point
+	const uint8_t X = uint8_t(x >> 8);
+	const uint8_t Y = uint8_t(y >> 8);
+
+	// Hash cube corner coordinates
+	const uint8_t A = uint8_t(P(X) + Y);
+	const uint8_t AA = P(A);
+	const uint8_t AB = P(A + 1);
+	const uint8_t B = uint8_t(P(X + 1) + Y);
+	const uint8_t BA = P(B);
+	const uint8_t BB = P(B + 1);
+
+	// Get the relative position of the point in the cube
+	uint8_t u = uint8_t(x);
+	uint8_t v = uint8_t(y);
+
+	// Get a signed version of the above for the grad function
+	const int8_t xx = (uint8_t(x) >> 1) & 0x7F;
+	const int8_t yy = (uint8_t(y) >> 1) & 0x7F;
+	const uint8_t N = 0x80;
+
+	u = ease8InOutQuad(u);
+	v = ease8InOutQuad(v);
+
+	const int8_t X1 = lerp7by8(grad8(P(AA), xx, yy), grad8(P(BA), xx - N, yy), u);
+	const int8_t X2 = lerp7by8(grad8(P(AB), xx, yy - N), grad8(P(BB), xx - N, yy - N), u);
+
+	return lerp7by8(X1, X2, v);
+}
+
+uint8_t inoise8(uint16_t x, uint16_t y)
+{
+	int8_t n = inoise8_raw(x, y); // -64..+64
+	n += 64;                      //   0..128
+	return qadd8(uint8_t(n), uint8_t(n)); // 0..255
+}
+
+int8_t inoise8_raw(uint16_t x)
+{
+	emuCountOp(EmuOp_inoise8);
+
+	// Find the unit cube containing the point
+	const uint8_t X = uint8_t(x >> 8);
+
+	// Hash cube corner coordinates
+	const uint8_t A = P(X);
+	const uint8_t AA = P(A);
+	const uint8_t B = P(X + 1);
+	const uint8_t BA = P(B);
+
+	// Get the relative position of the point in the cube
+	uint8_t u = uint8_t(x);
+
+	// Get a signed version of the above for the grad function
+	const int8_t xx = (uint8_t(x) >> 1) & 0x7F;
+	const uint8_t N = 0x80;
+
+	u = ease8InOutQuad(u);
+
+	return lerp7by8(grad8(P(AA), xx), grad8(P(BA), xx - N), u);
+}
+
+uint8_t inoise8(uint16_t x)
+{
+	int8_t n = inoise8_raw(x); // -64..+64
+	n += 64;                   //   0..128
+	return qadd8(uint8_t(n), uint8_t(n)); // 0..255
+}
+
+//------------------------------------------------------------------------------
+// controller
+//------------------------------------------------------------------------------
+
+CFastLED FastLED;
+
+void CLEDController::clearLeds(int nLeds)
+{
+	fill_solid(m_data, (nLeds < m_nLeds) ? nLeds : m_nLeds, CRGB::Black);
+}
+
+CLEDController &CFastLED::addLeds(CRGB *data, int nLedsOrOffset, int nLedsIfOffset)
+{
+	static CLEDController s_overflow;
+
+	const int nOffset = (nLedsIfOffset > 0) ? nLedsOrOffset : 0;
+	const int nLeds = (nLedsIfOffset > 0) ? nLedsIfOffset : nLedsOrOffset;
+
+	CLEDController &controller = (m_nControllers < MAX_CONTROLLERS) ? m_Controllers[m_nControllers++] : s_overflow;
+	return controller.setLeds(data + nOffset, nLeds);
+}
+
+void CFastLED::setCorrection(const CRGB &correction)
+{
+	for (uint8_t i = 0; i < m_nControllers; ++i)
+	{
+		m_Controllers[i].setCorrection(correction);
+	}
+}
+
+void CFastLED::setTemperature(const CRGB &temp)
+{
+	for (uint8_t i = 0; i < m_nControllers; ++i)
+	{
+		m_Controllers[i].setTemperature(temp);
+	}
+}
+
+void CFastLED::show(uint8_t scale)
+{
+	++m_nShowCount;
+	for (uint8_t c = 0; c < m_nControllers; ++c)
+	{
+		m_nTransmittedLeds += m_Controllers[c].size();
+	}
+	for (uint8_t i = 0; i < MAX_FRAME_SINKS; ++i)
+	{
+		if (m_FrameSinks[i])
+		{
+			for (uint8_t c = 0; c < m_nControllers; ++c)
+			{
+				m_FrameSinks[i]->showFrame(m_Controllers[c], scale);
+			}
+		}
+	}
+	countFPS();
+}
+
+void CFastLED::clear(bool writeData)
+{
+	if (writeData)
+	{
+		showColor(CRGB::Black, 0);
+	}
+	clearData();
+}
+
+void CFastLED::clearData()
+{
+	for (uint8_t i = 0; i < m_nControllers; ++i)
+	{
+		m_Controllers[i].clearLeds(m_Controllers[i].size());
+	}
+}
+
+void CFastLED::showColor(const CRGB &color, uint8_t scale)
+{
+	(void)color;
+	(void)scale;
+	++m_nShowCount;
+	for (uint8_t c = 0; c < m_nControllers; ++c)
+	{
+		m_nTransmittedLeds += m_Controllers[c].size();
+	}
+	countFPS();
+}
+
+void CFastLED::delay(unsigned long ms)
+{
+	const unsigned long start = millis();
+	do
+	{
+		show();
+		yield();
+	} while ((millis() - start) < ms);
+}
+
+void CFastLED::countFPS(int nFrames)
+{
+	static int br = 0;
+	static uint32_t lastframe = 0;
+
+	if (br++ >= nFrames)
+	{
+		const uint32_t now = millis();
+		const uint32_t elapsed = now - lastframe;
+		m_nFPS = uint16_t(elapsed ? (br * 1000) / elapsed : 0);
+		br = 0;
+		lastframe = now;
+	}
+}
+
+bool CFastLED::addFrameSink(CEmuFrameSink &sink)
+{
+	for (uint8_t i = 0; i < MAX_FRAME_SINKS; ++i)
+	{
+		if (m_FrameSinks[i] == nullptr)
+		{
+			m_FrameSinks[i] = &sink;
+			return true;
+		}
+	}
+	return false;
+}
+
+void CFastLED::removeFrameSink(CEmuFrameSink &sink)
+{
+	for (uint8_t i = 0; i < MAX_FRAME_SINKS; ++i)
+	{
+		if (m_FrameSinks[i] == &sink)
+		{
+			m_FrameSinks[i] = nullptr;
+		}
+	}
+}
+
+void CFastLED::resetOpCounts()
+{
+	for (uint8_t i = 0; i < EmuOp_COUNT; ++i)
+	{
+		emuOpCounts[i] = 0;
+	}
+}
+
+CLEDController &CFastLED::operator[](int x)
+{
+	return (x < m_nControllers) ? m_Controllers[x] : m_Controllers[0];
+}
+
+int CFastLED::size()
+{
+	return (*this)[0].size();
+}
+
+CRGB *CFastLED::leds()
+{
+	return (*this)[0].leds();
+}
 
 //------------------------------------------------------------------------------
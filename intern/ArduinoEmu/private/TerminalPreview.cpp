@@ -0,0 +1,291 @@
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+#include "../TerminalPreview.h"
+
+#include <cstdlib>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <io.h>
+#include <windows.h>
+#undef WIN32_LEAN_AND_MEAN
+#undef min
+#undef max
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+	/// Unchanged cells between two changed ones that are redrawn anyway,
+	/// because that is cheaper than repositioning the cursor.
+	const int MAX_GAP = 2;
+
+	uint16_t terminalColumns(FILE *file)
+	{
+#ifdef _WIN32
+		HANDLE console = HANDLE(_get_osfhandle(_fileno(file)));
+		DWORD mode = 0;
+		if (GetConsoleMode(console, &mode))
+		{
+			SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+		}
+		CONSOLE_SCREEN_BUFFER_INFO info;
+		if (GetConsoleScreenBufferInfo(console, &info))
+		{
+			return uint16_t(info.srWindow.Right - info.srWindow.Left + 1);
+		}
+#else
+		struct winsize size;
+		if (isatty(fileno(file)) && ioctl(fileno(file), TIOCGWINSZ, &size) == 0 && size.ws_col > 0)
+		{
+			return size.ws_col;
+		}
+#endif
+		const char *columns = getenv("COLUMNS");
+		const long value = columns ? strtol(columns, nullptr, 10) : 0;
+		return (value > 0 && value < 0x10000) ? uint16_t(value) : 80;
+	}
+
+	CRGB scaled(CRGB color, uint8_t brightness)
+	{
+		if (brightness != 255)
+		{
+			nscale8x3(color.r, color.g, color.b, brightness);
+		}
+		return color;
+	}
+} // namespace
+
+//------------------------------------------------------------------------------
+
+CEmuTerminalPreview::CEmuTerminalPreview(FILE *file, uint16_t maxFps, uint16_t columns)
+	: m_pFile(file),
+	  m_FrameInterval(maxFps ? std::chrono::duration_cast<Clock::duration>(std::chrono::microseconds(1000000 / maxFps))
+							 : Clock::duration::zero())
+{
+	// Leave the last column empty; writing there confuses some terminals' line wrapping.
+	m_nColumns = columns ? columns : terminalColumns(file);
+	if (m_nColumns > 1 && columns == 0)
+	{
+		--m_nColumns;
+	}
+}
+
+CEmuTerminalPreview::~CEmuTerminalPreview()
+{
+	if (m_nDrawnFrames)
+	{
+		m_Output += "\x1b[0m\x1b[?25h";
+		flush();
+	}
+}
+
+void CEmuTerminalPreview::restart()
+{
+	m_Blocks.clear();
+	m_nRows = 0;
+	m_bColorValid = false;
+}
+
+void CEmuTerminalPreview::draw(const CRGB *leds, int nLeds, uint8_t brightness)
+{
+	if (!leds || nLeds <= 0)
+	{
+		return;
+	}
+	++m_nDrawnFrames;
+	m_LastFrameTime = Clock::now();
+	drawBlock(getBlock(leds, nLeds), leds, nLeds, brightness);
+	flush();
+}
+
+void CEmuTerminalPreview::showFrame(CLEDController &controller, uint8_t brightness)
+{
+	// All strips of one FastLED.show() call are either drawn or skipped together.
+	const uint32_t show = FastLED.getShowCount();
+	if (show != m_nCurrentShow)
+	{
+		m_nCurrentShow = show;
+		const Clock::time_point now = Clock::now();
+		m_bDrawCurrentShow = (m_nDrawnFrames == 0) || (now - m_LastFrameTime >= m_FrameInterval);
+		if (m_bDrawCurrentShow)
+		{
+			m_LastFrameTime = now;
+			++m_nDrawnFrames;
+		}
+		else
+		{
+			++m_nSkippedFrames;
+		}
+	}
+
+	if (m_bDrawCurrentShow && controller.leds() && controller.size() > 0)
+	{
+		drawBlock(getBlock(&controller, controller.size()), controller.leds(), controller.size(),
+				  m_bApplyBrightness ? brightness : 255);
+		flush();
+	}
+}
+
+//------------------------------------------------------------------------------
+
+CEmuTerminalPreview::Block &CEmuTerminalPreview::getBlock(const void *key, int nLeds)
+{
+	for (Block &block : m_Blocks)
+	{
+		if (block.key == key)
+		{
+			// Like on a real strip, when fewer LEDs are shown, the remaining ones keep their color.
+			if (size_t(nLeds) <= block.cells.size())
+			{
+				return block;
+			}
+			// The strip grew; start over below the current preview.
+			restart();
+			break;
+		}
+	}
+
+	Block block;
+	block.key = key;
+	block.firstRow = m_nRows;
+	block.rows = uint16_t((nLeds + m_nColumns - 1) / m_nColumns);
+	m_Blocks.push_back(block);
+	return m_Blocks.back();
+}
+
+void CEmuTerminalPreview::drawBlock(Block &block, const CRGB *leds, int nLeds, uint8_t brightness)
+{
+	if (m_nRows == 0 && block.cells.empty())
+	{
+		m_Output += "\x1b[?25l";
+	}
+
+	// A new block is drawn completely, below all others (i.e. at the parking position).
+	if (block.cells.empty())
+	{
+		block.cells.resize(size_t(nLeds));
+		for (uint16_t row = 0; row < block.rows; ++row)
+		{
+			const int end = min(nLeds, (row + 1) * m_nColumns);
+			for (int i = row * m_nColumns; i < end; ++i)
+			{
+				block.cells[i] = scaled(leds[i], brightness);
+				appendColor(block.cells[i]);
+				m_Output += ' ';
+			}
+			m_Output += "\x1b[0m\n";
+			m_bColorValid = false;
+		}
+		m_nRows += block.rows;
+		return;
+	}
+
+	// Otherwise only the changed cells are redrawn; the cursor moves relative to the parking position.
+	char sequence[16];
+	uint16_t cursorRow = m_nRows;
+	for (uint16_t row = 0; row < block.rows; ++row)
+	{
+		const int start = row * m_nColumns;
+		const int end = min(nLeds, start + m_nColumns);
+		int i = start;
+		while (i < end)
+		{
+			while (i < end && block.cells[i] == scaled(leds[i], brightness))
+			{
+				++i;
+			}
+			if (i == end)
+			{
+				break;
+			}
+
+			int lastChanged = i;
+			for (int j = i + 1; j < end && j - lastChanged <= MAX_GAP; ++j)
+			{
+				if (block.cells[j] != scaled(leds[j], brightness))
+				{
+					lastChanged = j;
+				}
+			}
+
+			const uint16_t targetRow = block.firstRow + row;
+			if (cursorRow != targetRow)
+			{
+				snprintf(sequence, sizeof(sequence), (cursorRow > targetRow) ? "\x1b[%uF" : "\x1b[%uE",
+						 unsigned(cursorRow > targetRow ? cursorRow - targetRow : targetRow - cursorRow));
+				m_Output += sequence;
+				cursorRow = targetRow;
+			}
+			snprintf(sequence, sizeof(sequence), "\x1b[%uG", unsigned(i - start + 1));
+			m_Output += sequence;
+
+			for (; i <= lastChanged; ++i)
+			{
+				block.cells[i] = scaled(leds[i], brightness);
+				appendColor(block.cells[i]);
+				m_Output += ' ';
+			}
+		}
+	}
+
+	if (cursorRow != m_nRows)
+	{
+		snprintf(sequence, sizeof(sequence), "\x1b[0m\x1b[%uE", unsigned(m_nRows - cursorRow));
+		m_Output += sequence;
+		m_bColorValid = false;
+	}
+}
+
+void CEmuTerminalPreview::appendColor(const CRGB &color)
+{
+	if (m_bColorValid && color == m_LastColor)
+	{
+		return;
+	}
+	char sequence[24];
+	snprintf(sequence, sizeof(sequence), "\x1b[48;2;%u;%u;%um", color.r, color.g, color.b);
+	m_Output += sequence;
+	m_LastColor = color;
+	m_bColorValid = true;
+}
+
+void CEmuTerminalPreview::flush()
+{
+	if (!m_Output.empty())
+	{
+		m_nBytesWritten += fwrite(m_Output.data(), 1, m_Output.size(), m_pFile);
+		fflush(m_pFile);
+		m_Output.clear();
+	}
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,126 @@
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2020 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+// Runs an Arduino sketch on the PC, like the Arduino core's main() does.
+//
+// Usage: <sketch> [seconds]
+// When seconds is given (and nonzero), the sketch terminates after that time.
+//
+// Usage: <sketch> --headless <seconds> [tick-us]
+// Runs the sketch with a simulated clock as fast as possible, advancing the
+// clock by tick-us microseconds (default: 1000) after each loop() call.
+// Reports the number of frames (FastLED.show() calls) and the wall-clock cost.
+//
+// Both accept --preview as first argument, which draws the LED strips to the
+// terminal (on stderr, so that Serial output on stdout can be redirected).
+// In headless mode, the preview is throttled to real time and thus shows only
+// a sample of the frames.
+
+#include "../Arduino.h"
+#include "../FastLED.h"
+#include "../TerminalPreview.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+	int runRealtime(unsigned long runtime)
+	{
+		setup();
+
+		const unsigned long startTime = millis();
+		while (runtime == 0 || (millis() - startTime) < runtime)
+		{
+			loop();
+		}
+
+		Serial.flush();
+		return 0;
+	}
+
+	int runHeadless(uint64_t runtimeMicros, uint32_t tickMicros)
+	{
+		typedef std::chrono::steady_clock Clock;
+
+		ArduinoEmu::enableSimulatedClock();
+		const Clock::time_point wallStart = Clock::now();
+
+		setup();
+
+		uint64_t loops = 0;
+		while (ArduinoEmu::getSimulatedMicros() < runtimeMicros)
+		{
+			loop();
+			ArduinoEmu::advanceSimulatedClock(tickMicros);
+			++loops;
+		}
+
+		const double wallSeconds = std::chrono::duration<double>(Clock::now() - wallStart).count();
+		const double simSeconds = double(ArduinoEmu::getSimulatedMicros()) / 1e6;
+		const uint32_t frames = FastLED.getShowCount();
+
+		Serial.flush();
+		fprintf(stderr, "simulated: %.1f s, %llu loops, %lu frames (%.1f fps)\n",
+				simSeconds, (unsigned long long)loops, (unsigned long)frames,
+				(simSeconds > 0.0) ? frames / simSeconds : 0.0);
+		fprintf(stderr, "wall-clock: %.3f s, %.0f ns/frame, %.0fx realtime\n",
+				wallSeconds, frames ? wallSeconds * 1e9 / frames : 0.0,
+				(wallSeconds > 0.0) ? simSeconds / wallSeconds : 0.0);
+		return 0;
+	}
+} // namespace
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+	const char *program = argv[0];
+	CEmuTerminalPreview preview(stderr);
+	if (argc > 1 && strcmp(argv[1], "--preview") == 0)
+	{
+		preview.attach();
+		--argc;
+		++argv;
+	}
+
+	if (argc > 1 && strcmp(argv[1], "--headless") == 0)
+	{
+		if (argc < 3)
+		{
+			fprintf(stderr, "Usage: %s [--preview] --headless <seconds> [tick-us]\n", program);
+			return 1;
+		}
+		const uint64_t runtime = uint64_t(strtoul(argv[2], nullptr, 10)) * 1000000;
+		const unsigned long tick = (argc > 3) ? strtoul(argv[3], nullptr, 10) : 1000;
+		return runHeadless(runtime, tick ? uint32_t(tick) : 1000);
+	}
+
+	return runRealtime((argc > 1) ? strtoul(argv[1], nullptr, 10) * 1000 : 0);
+}
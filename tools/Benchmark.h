@@ -0,0 +1,182 @@
+#pragma once
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+#ifndef ARDUINO_EMU
+#error "Benchmark.h is only available for the host build (intern/ArduinoEmu)"
+#endif
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+namespace EC
+{
+
+  /// Result of a single micro-benchmark.
+  struct BenchmarkResult
+  {
+    /// Name of the benchmark.
+    const char *name;
+
+    /// Length of the LED strip.
+    uint16_t ledCount;
+
+    /// Number of measured calls (per repetition).
+    uint32_t iterations;
+
+    /// Median duration of one call (in ns).
+    double nsPerCall;
+
+    /// Fastest duration of one call (in ns).
+    double nsPerCallMin;
+
+    /// Median duration per LED (in ns).
+    double nsPerLed() const { return ledCount ? nsPerCall / ledCount : 0.0; }
+  };
+
+  //------------------------------------------------------------------------------
+
+  /** Helper for running micro-benchmarks and reporting their results.
+   * Every benchmark is calibrated to run for at least \a minMillis, and then
+   * measured \a repetitions times; the median is reported.
+   */
+  class BenchmarkRunner
+  {
+  public:
+    /// Minimum duration of one measurement (in ms).
+    uint32_t minMillis = 20;
+
+    /// Number of measurements per benchmark.
+    uint8_t repetitions = 5;
+
+    /** Measure the given \a benchmark function.
+     * @param name  Name of the benchmark (must outlive this object).
+     * @param ledCount  Length of the LED strip that \a benchmark operates on.
+     * @param benchmark  Function object that is called with the iteration number.
+     * @param prepare  Function object that is called before each measurement (not measured).
+     */
+    template <typename BenchmarkFct, typename PrepareFct>
+    const BenchmarkResult &run(const char *name, uint16_t ledCount, BenchmarkFct benchmark, PrepareFct prepare)
+    {
+      // Calibrate the number of iterations
+      uint32_t iterations = 1;
+      for (;;)
+      {
+        prepare();
+        if (measure(benchmark, iterations) >= minMillis * 1e6 || iterations >= (1UL << 30))
+        {
+          break;
+        }
+        iterations *= 2;
+      }
+
+      std::vector<double> samples;
+      for (uint8_t i = 0; i < max(repetitions, uint8_t(1)); ++i)
+      {
+        prepare();
+        samples.push_back(measure(benchmark, iterations) / iterations);
+      }
+      std::sort(samples.begin(), samples.end());
+
+      _results.push_back({name, ledCount, iterations, samples[samples.size() / 2], samples.front()});
+      return _results.back();
+    }
+
+    /// Same as above, but without any preparation.
+    template <typename BenchmarkFct>
+    const BenchmarkResult &run(const char *name, uint16_t ledCount, BenchmarkFct benchmark)
+    {
+      return run(name, ledCount, benchmark, [] {});
+    }
+
+    /// All results so far.
+    const std::vector<BenchmarkResult> &results() const { return _results; }
+
+    /// Print all results as CSV.
+    void printCsv(FILE *file) const
+    {
+      fprintf(file, "name,leds,iterations,ns_per_call,ns_per_call_min,ns_per_led\n");
+      for (const auto &result : _results)
+      {
+        fprintf(file, "%s,%u,%lu,%.2f,%.2f,%.4f\n",
+                result.name, unsigned(result.ledCount), (unsigned long)result.iterations,
+                result.nsPerCall, result.nsPerCallMin, result.nsPerLed());
+      }
+    }
+
+    /// Print all results as JSON.
+    void printJson(FILE *file) const
+    {
+      fprintf(file, "{\n  \"benchmarks\": [");
+      const char *separator = "\n";
+      for (const auto &result : _results)
+      {
+        fprintf(file, "%s    {\"name\": \"%s\", \"leds\": %u, \"iterations\": %lu, "
+                      "\"ns_per_call\": %.2f, \"ns_per_call_min\": %.2f, \"ns_per_led\": %.4f}",
+                separator, result.name, unsigned(result.ledCount), (unsigned long)result.iterations,
+                result.nsPerCall, result.nsPerCallMin, result.nsPerLed());
+        separator = ",\n";
+      }
+      fprintf(file, "\n  ]\n}\n");
+    }
+
+    /// Print all results as human readable table.
+    void printTable(FILE *file) const
+    {
+      fprintf(file, "%-24s %6s %12s %12s %10s\n", "name", "leds", "ns/call", "min ns/call", "ns/led");
+      for (const auto &result : _results)
+      {
+        fprintf(file, "%-24s %6u %12.1f %12.1f %10.3f\n",
+                result.name, unsigned(result.ledCount), result.nsPerCall, result.nsPerCallMin, result.nsPerLed());
+      }
+    }
+
+  private:
+    /// Duration of \a iterations calls of \a benchmark (in ns).
+    template <typename BenchmarkFct>
+    static double measure(BenchmarkFct &benchmark, uint32_t iterations)
+    {
+      typedef std::chrono::steady_clock Clock;
+      const Clock::time_point start = Clock::now();
+      for (uint32_t i = 0; i < iterations; ++i)
+      {
+        benchmark(i);
+      }
+      return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+
+    std::vector<BenchmarkResult> _results;
+  };
+
+} // namespace EC
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,436 @@
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+// Tracks the memory footprint of EyeCandy against a checked-in baseline:
+// - sizeof() of every Animation (host sizes; pointers etc. are larger than on AVR)
+// - heap consumption of every preset, i.e. everything that SetupEnv::add() allocates
+// - flash and static RAM of the example sketches, either of the host build
+//   (via the size tool) or of the AVR build (from the output of arduino-cli)
+//
+// The host sizes of the sketches depend on the compiler and its version, so the
+// baseline records the toolchain they were measured with. With another toolchain,
+// they are not compared; only the AVR sizes tell the footprint on the target.
+//
+// Usage: Footprint [--baseline FILE [--update]] [--threshold PCT] [--toolchain ID]
+//                  [--host NAME=EXECUTABLE]... [--avr NAME=LOGFILE]...
+//   --baseline FILE  Compare against this baseline; fail when any value grew
+//                    by more than the threshold. Without it, just print all values.
+//   --update         Write the current values into the baseline instead.
+//   --threshold PCT  Accepted growth in percent (default: 1).
+//   --toolchain ID   Compiler of the host executables, e.g. "GNU-12.2.0-x86_64".
+//   --host ...       Host executable of a sketch, measured with the size tool.
+//   --avr ...        Output of "arduino-cli compile" for a sketch.
+
+// Same size as the default NUM_LEDS of the example sketches.
+#define EC_PRESET_CATALOG_MAX_LEDS 120
+
+#include "HeapTracker.h"
+#include "PresetCatalog.h"
+
+#include <EyeCandy.h>
+
+#include <Animation_IO_config.h>
+
+#include <map>
+#include <string>
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+  /// All measured values; the key is "<kind> <name>".
+  typedef std::map<std::string, unsigned long> Footprint;
+
+  void addSizes(Footprint &footprint)
+  {
+#define EC_SIZEOF(TYPE) footprint["sizeof " #TYPE] = sizeof(EC::TYPE)
+    EC_SIZEOF(AnimationScene);
+    EC_SIZEOF(AnimationSceneStatic);
+    EC_SIZEOF(AnimationChanger);
+    EC_SIZEOF(AnimationChangerSoft);
+    EC_SIZEOF(BallLightning);
+    EC_SIZEOF(BallLightningVU);
+    EC_SIZEOF(BgFadeToBlack);
+    EC_SIZEOF(BgFillColor);
+    EC_SIZEOF(BgMeteorFadeToBlack);
+    EC_SIZEOF(BgRotate);
+    EC_SIZEOF(Blur);
+    EC_SIZEOF(BouncingBalls<>);
+    EC_SIZEOF(Bubbles);
+    EC_SIZEOF(ColorChangerNoiseRGB);
+    EC_SIZEOF(ColorChangerRainbow);
+    EC_SIZEOF(ColorChangerSineRGB);
+    EC_SIZEOF(ColorClouds);
+    EC_SIZEOF(DancingJellyfishVU);
+    EC_SIZEOF(Fire2012<NUM_LEDS>);
+    EC_SIZEOF(Fire2012Changer<NUM_LEDS>);
+    EC_SIZEOF(Fire2012VU<NUM_LEDS>);
+    EC_SIZEOF(Firework<>);
+    EC_SIZEOF(FloatingBlobs);
+    EC_SIZEOF(FlowingBeatVU);
+    EC_SIZEOF(Glitter);
+    EC_SIZEOF(Kaleidoscope);
+    EC_SIZEOF(KITT);
+    EC_SIZEOF(Lavalamp);
+    EC_SIZEOF(LayeredScene);
+    EC_SIZEOF(LightbulbVU);
+    EC_SIZEOF(Meteor);
+    EC_SIZEOF(Pacifica);
+    EC_SIZEOF(Pride2015);
+    EC_SIZEOF(Rainbow);
+    EC_SIZEOF(RainbowBuiltin);
+    EC_SIZEOF(RainbowDrips);
+    EC_SIZEOF(RainbowTwinkle);
+    EC_SIZEOF(RetroPartyLight);
+    EC_SIZEOF(RetroPartyVU);
+    EC_SIZEOF(RgbBlocks);
+    EC_SIZEOF(TriggerPattern);
+    EC_SIZEOF(Twinkles);
+    EC_SIZEOF(VuAnalogInputPin);
+    EC_SIZEOF(VuOverlayDot);
+    EC_SIZEOF(VuOverlayLine);
+    EC_SIZEOF(VuOverlayPeakGlitter);
+    EC_SIZEOF(VuOverlayRainbowDot);
+    EC_SIZEOF(VuOverlayRainbowLine);
+    EC_SIZEOF(VuOverlayRainbowStripe);
+    EC_SIZEOF(VuOverlayStripe);
+    EC_SIZEOF(VuSourcePeakForce);
+    EC_SIZEOF(VuSourcePeakGravity);
+    EC_SIZEOF(VuSourcePeakHold);
+    EC_SIZEOF(Waterfall);
+
+    // Helpers
+    EC_SIZEOF(FastLedStrip);
+    EC_SIZEOF(FrameChangeDetector);
+    EC_SIZEOF(SetupEnv);
+#undef EC_SIZEOF
+  }
+
+  EC::VuSource &makeVuSource(EC::SetupEnv &env)
+  {
+    return env.add(new EC::VuAnalogInputPin(PIN_MIC));
+  }
+
+  void addHeapUsage(Footprint &footprint)
+  {
+    CRGB leds[NUM_LEDS];
+    EC::AnimationScene scene;
+    EC::SetupEnv setupEnv({leds, NUM_LEDS}, scene, &makeVuSource);
+
+    for (const EC::PresetEntry *catalog : {EC::allPatternPresets, EC::allVuPresets})
+    {
+      for (const EC::PresetEntry *preset = catalog; preset->maker; ++preset)
+      {
+        setupEnv.reset();
+        const size_t heapBefore = EC::HeapTracker::currentBytes();
+        preset->maker(setupEnv);
+        footprint[std::string("heap ") + preset->name] = EC::HeapTracker::currentBytes() - heapBefore;
+      }
+    }
+    setupEnv.reset();
+  }
+
+  /// Split "NAME=VALUE" into its parts.
+  bool splitArg(const char *arg, std::string &name, std::string &value)
+  {
+    const char *separator = strchr(arg, '=');
+    if (!separator)
+    {
+      return false;
+    }
+    name.assign(arg, separator);
+    value = separator + 1;
+    return true;
+  }
+
+  /// Measure the host executable of a sketch with the size tool.
+  bool addHostSketch(Footprint &footprint, const std::string &name, const std::string &executable)
+  {
+    const std::string command = "size -B \"" + executable + "\"";
+    FILE *pipe = popen(command.c_str(), "r");
+    if (!pipe)
+    {
+      return false;
+    }
+    char header[256];
+    unsigned long text = 0, data = 0, bss = 0;
+    const bool success = fgets(header, sizeof(header), pipe) && fscanf(pipe, "%lu %lu %lu", &text, &data, &bss) == 3;
+    const bool exitedNormally = (pclose(pipe) == 0);
+    if (success && exitedNormally)
+    {
+      footprint["host-flash " + name] = text + data;
+      footprint["host-ram " + name] = data + bss;
+    }
+    return success && exitedNormally;
+  }
+
+  /// Extract flash and static RAM of a sketch from the output of arduino-cli.
+  bool addAvrSketch(Footprint &footprint, const std::string &name, const std::string &logFile)
+  {
+    FILE *file = fopen(logFile.c_str(), "r");
+    if (!file)
+    {
+      return false;
+    }
+    char line[512];
+    unsigned long value = 0;
+    uint8_t found = 0;
+    while (fgets(line, sizeof(line), file))
+    {
+      if (sscanf(line, "Sketch uses %lu bytes", &value) == 1)
+      {
+        footprint["avr-flash " + name] = value;
+        ++found;
+      }
+      else if (sscanf(line, "Global variables use %lu bytes", &value) == 1)
+      {
+        footprint["avr-ram " + name] = value;
+        ++found;
+      }
+    }
+    fclose(file);
+    return found == 2;
+  }
+
+  /// Prefix of the baseline's first line, which names the toolchain of the host sizes.
+  const char TOOLCHAIN_PREFIX[] = "# host-toolchain ";
+
+  bool load(Footprint &footprint, std::string &toolchain, const std::string &path)
+  {
+    FILE *file = fopen(path.c_str(), "r");
+    if (!file)
+    {
+      return false;
+    }
+    char header[128];
+    if (fgets(header, sizeof(header), file) && strncmp(header, TOOLCHAIN_PREFIX, strlen(TOOLCHAIN_PREFIX)) == 0)
+    {
+      toolchain = header + strlen(TOOLCHAIN_PREFIX);
+      toolchain.erase(toolchain.find_last_not_of("\r\n") + 1);
+    }
+    else
+    {
+      rewind(file);
+    }
+    // Every other line is "<kind> <name> <value>"; the names must not contain whitespace.
+    char kind[32], name[224];
+    unsigned long value = 0;
+    while (fscanf(file, "%31s %223s %lu", kind, name, &value) == 3)
+    {
+      footprint[std::string(kind) + " " + name] = value;
+    }
+    const bool complete = feof(file) && !ferror(file);
+    if (!complete)
+    {
+      fprintf(stderr, "%s: cannot parse the entry after %u values\n", path.c_str(), unsigned(footprint.size()));
+    }
+    fclose(file);
+    return complete;
+  }
+
+  bool save(const Footprint &footprint, const std::string &toolchain, const std::string &path)
+  {
+    FILE *file = fopen(path.c_str(), "w");
+    if (!file)
+    {
+      return false;
+    }
+    if (!toolchain.empty())
+    {
+      fprintf(file, "%s%s\n", TOOLCHAIN_PREFIX, toolchain.c_str());
+    }
+    bool success = true;
+    for (const auto &entry : footprint)
+    {
+      // load() can only read back names without whitespace.
+      if (entry.first.find(' ') != entry.first.rfind(' '))
+      {
+        fprintf(stderr, "Invalid name (contains whitespace): %s\n", entry.first.c_str());
+        success = false;
+        continue;
+      }
+      fprintf(file, "%s %lu\n", entry.first.c_str(), entry.second);
+    }
+    return (fclose(file) == 0) && success;
+  }
+
+  /// Check if \a key is a size of a host executable.
+  bool isHostSketch(const std::string &key)
+  {
+    return key.compare(0, 5, "host-") == 0;
+  }
+
+  /** Compare all values against the \a baseline.
+   * @param compareHost  Also compare the sizes of the host executables.
+   * @return Number of values that grew beyond the threshold.
+   */
+  unsigned compare(const Footprint &baseline, const Footprint &current, double thresholdPercent, bool compareHost)
+  {
+    unsigned failed = 0;
+    for (const auto &entry : current)
+    {
+      if (!compareHost && isHostSketch(entry.first))
+      {
+        continue;
+      }
+      const auto found = baseline.find(entry.first);
+      if (found == baseline.end())
+      {
+        printf("NEW      %-48s %8lu\n", entry.first.c_str(), entry.second);
+        continue;
+      }
+      const unsigned long before = found->second;
+      const unsigned long now = entry.second;
+      if (now == before)
+      {
+        continue;
+      }
+      const bool grewTooMuch = now > before + before * thresholdPercent / 100.0;
+      failed += grewTooMuch ? 1 : 0;
+      printf("%-8s %-48s %8lu -> %8lu (%+ld)\n", grewTooMuch ? "GREW" : "changed",
+             entry.first.c_str(), before, now, long(now) - long(before));
+    }
+    for (const auto &entry : baseline)
+    {
+      if (!compareHost && isHostSketch(entry.first))
+      {
+        continue;
+      }
+      if (current.find(entry.first) == current.end())
+      {
+        printf("GONE     %-48s %8lu\n", entry.first.c_str(), entry.second);
+      }
+    }
+    return failed;
+  }
+
+  int usage(const char *program)
+  {
+    fprintf(stderr, "Usage: %s [--baseline FILE [--update]] [--threshold PCT] [--toolchain ID] [--host NAME=EXECUTABLE]... [--avr NAME=LOGFILE]...\n", program);
+    return 2;
+  }
+} // namespace
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+  std::string baselineFile;
+  std::string toolchain;
+  bool update = false;
+  double thresholdPercent = 1.0;
+  Footprint current;
+
+  addSizes(current);
+  addHeapUsage(current);
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const char *arg = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    std::string name, value;
+    if (strcmp(arg, "--baseline") == 0 && hasValue)
+    {
+      baselineFile = argv[++i];
+    }
+    else if (strcmp(arg, "--update") == 0)
+    {
+      update = true;
+    }
+    else if (strcmp(arg, "--threshold") == 0 && hasValue)
+    {
+      thresholdPercent = strtod(argv[++i], nullptr);
+    }
+    else if (strcmp(arg, "--toolchain") == 0 && hasValue)
+    {
+      toolchain = argv[++i];
+    }
+    else if (strcmp(arg, "--host") == 0 && hasValue && splitArg(argv[++i], name, value))
+    {
+      if (!addHostSketch(current, name, value))
+      {
+        fprintf(stderr, "Cannot measure %s\n", value.c_str());
+        return 2;
+      }
+    }
+    else if (strcmp(arg, "--avr") == 0 && hasValue && splitArg(argv[++i], name, value))
+    {
+      if (!addAvrSketch(current, name, value))
+      {
+        fprintf(stderr, "No memory usage found in %s\n", value.c_str());
+        return 2;
+      }
+    }
+    else
+    {
+      return usage(argv[0]);
+    }
+  }
+
+  if (baselineFile.empty())
+  {
+    for (const auto &entry : current)
+    {
+      printf("%s %lu\n", entry.first.c_str(), entry.second);
+    }
+    return 0;
+  }
+
+  if (update)
+  {
+    if (!save(current, toolchain, baselineFile))
+    {
+      fprintf(stderr, "Cannot write %s\n", baselineFile.c_str());
+      return 2;
+    }
+    printf("Baseline %s updated (%u values)\n", baselineFile.c_str(), unsigned(current.size()));
+    return 0;
+  }
+
+  Footprint baseline;
+  std::string baselineToolchain;
+  if (!load(baseline, baselineToolchain, baselineFile))
+  {
+    fprintf(stderr, "Cannot read %s\n", baselineFile.c_str());
+    return 2;
+  }
+  const bool compareHost = (toolchain == baselineToolchain);
+  if (!compareHost)
+  {
+    printf("Skipping the host sizes of the sketches: baseline was measured with \"%s\", not with \"%s\"\n",
+           baselineToolchain.c_str(), toolchain.c_str());
+  }
+  const unsigned failed = compare(baseline, current, thresholdPercent, compareHost);
+  if (failed)
+  {
+    printf("\n%u values grew by more than %.1f%%\n", failed, thresholdPercent);
+    return 1;
+  }
+  printf("Footprint within %.1f%% of the baseline\n", thresholdPercent);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,360 @@
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+// Records and verifies golden frames of all presets from PatternPresets.h and
+// VuPresets.h, as safety net for optimizations that must not change the output.
+// Every preset is rendered with a fixed random seed and the simulated clock;
+// VU presets are fed with a synthetic (but deterministic) audio signal.
+//
+// Usage: GoldenFrameCheck record [--dir D] [--seconds N] [--leds N] [--frames] [preset...]
+//        GoldenFrameCheck verify [--dir D] [--tolerance N] [--skip-idle] [preset...]
+//   --dir D        Location of the golden files (default: tools/golden).
+//   --seconds N    Simulated time per preset (default: 5).
+//   --leds N       Length of the LED strip (default: 60).
+//   --frames       Record also the raw frames (not checked in). Required by
+//                  verify for determining the max per-channel error.
+//   --tolerance N  Accept deviations up to N per color channel (default: 0).
+//                  Only possible when the raw frames were recorded.
+//   --skip-idle    Advance the clock directly to the next deadline of the preset,
+//                  like a sketch that sleeps while the Animations are idle.
+//                  Must not change any frame.
+//   preset...      Only these presets (with or without "make_" prefix).
+//
+// Every preset is rendered in its own child process, so that it always starts
+// with fresh static state (like the function-static wave counters of Pacifica).
+// The results don't depend on which other presets are rendered before.
+//
+// Typical workflow for an optimization that may change the output slightly:
+// "record --frames" before the change, "verify --tolerance N" after it, and
+// finally "record" again if the deviation is acceptable.
+
+#include "GoldenFrames.h"
+#include "HeadlessRenderer.h"
+#include "PresetCatalog.h"
+#include "SyntheticAudio.h"
+
+#include <Animation_IO_config.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifndef EC_GOLDEN_DIR
+#define EC_GOLDEN_DIR "golden"
+#endif
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+  bool skipIdle = false;
+
+  EC::VuSource &makeVuSource(EC::SetupEnv &env)
+  {
+    return env.add(new EC::VuAnalogInputPin(PIN_MIC));
+  }
+
+  void feedMicrophone(uint32_t currentMillis)
+  {
+    EC::feedSyntheticAudio(currentMillis, PIN_MIC);
+  }
+
+  const EC::PresetEntry *findPreset(const char *name)
+  {
+    const EC::PresetEntry *preset = EC::findPreset(EC::allPatternPresets, name);
+    return preset ? preset : EC::findPreset(EC::allVuPresets, name);
+  }
+
+  /** Run \a action in a child process, which gets a copy of the initial state of this process.
+   * @return The exit code of \a action, or 2 when the child process failed.
+   */
+  template <class Action>
+  int runIsolated(Action action)
+  {
+    fflush(stdout);
+    fflush(stderr);
+    const pid_t pid = fork();
+    if (pid < 0)
+    {
+      perror("fork");
+      return 2;
+    }
+    if (pid == 0)
+    {
+      const int result = action();
+      fflush(stdout);
+      fflush(stderr);
+      _exit(result);
+    }
+    int status = 0;
+    if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status))
+    {
+      fprintf(stderr, "Rendering crashed\n");
+      return 2;
+    }
+    return WEXITSTATUS(status);
+  }
+
+  /// Render the given \a preset with the settings from \a golden and record its frames.
+  void render(const EC::PresetEntry &preset, EC::GoldenFrames &golden, bool keepFrames)
+  {
+    // Like on the real hardware, there is only one LED strip; just its size varies.
+    static CLEDController &controller = FastLED.addLeds<NEOPIXEL, LED_PIN>(nullptr, 0);
+    std::vector<CRGB> leds(golden.ledCount);
+    controller.setLeds(leds.data(), golden.ledCount);
+
+    EC::AnimationScene scene;
+    EC::SetupEnv setupEnv({leds.data(), int16_t(golden.ledCount)}, scene, &makeVuSource);
+
+    ArduinoEmu::enableSimulatedClock();
+    randomSeed(golden.seed);
+    random16_set_seed(golden.seed);
+    FastLED.setBrightness(255);
+
+    golden.hashes.clear();
+    golden.frames.clear();
+    preset.maker(setupEnv);
+    {
+      EC::GoldenFrameRecorder recorder(golden, keepFrames);
+      EC::HeadlessRenderer renderer;
+      renderer.tickMicros = golden.tickMicros;
+      renderer.onTick = &feedMicrophone;
+      renderer.skipIdle = skipIdle;
+      renderer.render(scene, golden.durationMillis);
+    }
+    scene.reset();
+
+    // Detach the LED array, which is about to be freed
+    controller.setLeds(nullptr, 0);
+  }
+
+  int record(const std::string &dir, const std::vector<const EC::PresetEntry *> &presets,
+             uint32_t seconds, uint16_t ledCount, bool keepFrames)
+  {
+    int result = 0;
+    for (const EC::PresetEntry *preset : presets)
+    {
+      const int presetResult = runIsolated([&]()
+                                           {
+        EC::GoldenFrames golden;
+        golden.preset = preset->name;
+        golden.ledCount = ledCount;
+        golden.durationMillis = seconds * 1000;
+        golden.tickMicros = 1000;
+        golden.seed = 1;
+        render(*preset, golden, keepFrames);
+
+        const std::string path = dir + "/" + preset->name + ".txt";
+        if (!golden.save(path))
+        {
+          fprintf(stderr, "Cannot write %s\n", path.c_str());
+          return 1;
+        }
+        printf("%-32s %5lu frames recorded\n", preset->name, (unsigned long)golden.hashes.size());
+        return 0; });
+      if (presetResult)
+      {
+        result = 1;
+      }
+    }
+    return result;
+  }
+
+  /// @return \c true when the current frames of the preset match the golden ones.
+  bool verify(const EC::PresetEntry &preset, const EC::GoldenFrames &golden, uint8_t tolerance)
+  {
+    EC::GoldenFrames current = golden;
+    render(preset, current, golden.hasFrames());
+
+    const size_t frameCount = min(golden.hashes.size(), current.hashes.size());
+    size_t firstDiverging = frameCount;
+    for (size_t i = 0; i < frameCount; ++i)
+    {
+      if (golden.hashes[i] != current.hashes[i])
+      {
+        firstDiverging = i;
+        break;
+      }
+    }
+    const bool sameFrameCount = golden.hashes.size() == current.hashes.size();
+    if (firstDiverging == frameCount && sameFrameCount)
+    {
+      printf("%-32s OK (%lu frames)\n", preset.name, (unsigned long)frameCount);
+      return true;
+    }
+    if (!sameFrameCount)
+    {
+      printf("%-32s frame count differs: %lu golden, %lu now\n", preset.name,
+             (unsigned long)golden.hashes.size(), (unsigned long)current.hashes.size());
+      if (firstDiverging == frameCount)
+      {
+        return false;
+      }
+    }
+
+    printf("%-32s DIVERGED at frame %lu of %lu", preset.name,
+           (unsigned long)firstDiverging, (unsigned long)golden.hashes.size());
+    if (!golden.hasFrames())
+    {
+      printf(" (no raw frames recorded; max error unknown)\n");
+      return false;
+    }
+
+    uint8_t maxError = 0;
+    size_t maxErrorFrame = 0;
+    const size_t frameSize = golden.frameSize();
+    for (size_t i = firstDiverging; i < frameCount; ++i)
+    {
+      for (size_t k = 0; k < frameSize; ++k)
+      {
+        const uint8_t a = golden.frames[i * frameSize + k];
+        const uint8_t b = current.frames[i * frameSize + k];
+        const uint8_t error = (a > b) ? a - b : b - a;
+        if (error > maxError)
+        {
+          maxError = error;
+          maxErrorFrame = i;
+        }
+      }
+    }
+    const bool withinTolerance = sameFrameCount && maxError <= tolerance;
+    printf(", max channel error %u at frame %lu%s\n", unsigned(maxError),
+           (unsigned long)maxErrorFrame, withinTolerance ? " (within tolerance)" : "");
+    return withinTolerance;
+  }
+
+  int usage(const char *program)
+  {
+    fprintf(stderr, "Usage: %s record [--dir D] [--seconds N] [--leds N] [--frames] [preset...]\n", program);
+    fprintf(stderr, "       %s verify [--dir D] [--tolerance N] [--skip-idle] [preset...]\n", program);
+    return 2;
+  }
+} // namespace
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+  if (argc < 2 || (strcmp(argv[1], "record") != 0 && strcmp(argv[1], "verify") != 0))
+  {
+    return usage(argv[0]);
+  }
+  const bool recording = (strcmp(argv[1], "record") == 0);
+
+  std::string dir = EC_GOLDEN_DIR;
+  uint32_t seconds = 5;
+  uint16_t ledCount = 60;
+  bool keepFrames = false;
+  uint8_t tolerance = 0;
+  std::vector<const EC::PresetEntry *> presets;
+
+  for (int i = 2; i < argc; ++i)
+  {
+    const char *arg = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (strcmp(arg, "--dir") == 0 && hasValue)
+    {
+      dir = argv[++i];
+    }
+    else if (strcmp(arg, "--seconds") == 0 && hasValue && recording)
+    {
+      seconds = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(arg, "--leds") == 0 && hasValue && recording)
+    {
+      ledCount = uint16_t(strtoul(argv[++i], nullptr, 10));
+    }
+    else if (strcmp(arg, "--frames") == 0 && recording)
+    {
+      keepFrames = true;
+    }
+    else if (strcmp(arg, "--tolerance") == 0 && hasValue && !recording)
+    {
+      tolerance = uint8_t(strtoul(argv[++i], nullptr, 10));
+    }
+    else if (strcmp(arg, "--skip-idle") == 0 && !recording)
+    {
+      skipIdle = true;
+    }
+    else if (arg[0] == '-')
+    {
+      return usage(argv[0]);
+    }
+    else
+    {
+      const EC::PresetEntry *preset = findPreset(arg);
+      if (!preset)
+      {
+        fprintf(stderr, "Unknown preset: %s\n", arg);
+        return 2;
+      }
+      presets.push_back(preset);
+    }
+  }
+  if (ledCount == 0 || ledCount > EC_PRESET_CATALOG_MAX_LEDS)
+  {
+    return usage(argv[0]);
+  }
+  if (presets.empty())
+  {
+    for (const EC::PresetEntry *catalog : {EC::allPatternPresets, EC::allVuPresets})
+    {
+      for (const EC::PresetEntry *preset = catalog; preset->maker; ++preset)
+      {
+        presets.push_back(preset);
+      }
+    }
+  }
+
+  if (recording)
+  {
+    return record(dir, presets, seconds, ledCount, keepFrames);
+  }
+
+  uint16_t failed = 0;
+  for (const EC::PresetEntry *preset : presets)
+  {
+    const int presetResult = runIsolated([&]()
+                                         {
+      EC::GoldenFrames golden;
+      if (!golden.load(dir + "/" + preset->name + ".txt"))
+      {
+        printf("%-32s MISSING golden frames\n", preset->name);
+        return 1;
+      }
+      return verify(*preset, golden, tolerance) ? 0 : 1; });
+    if (presetResult)
+    {
+      ++failed;
+    }
+  }
+  if (failed)
+  {
+    printf("\n%u of %u presets FAILED\n", unsigned(failed), unsigned(presets.size()));
+  }
+  return failed ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
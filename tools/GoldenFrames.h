@@ -0,0 +1,211 @@
+#pragma once
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+#ifndef ARDUINO_EMU
+#error "GoldenFrames.h is only available for the host build (intern/ArduinoEmu)"
+#endif
+
+#include <FastLED.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+namespace EC
+{
+
+  /// FNV-1a hash over the RGB data of a frame and the global \a brightness.
+  inline uint32_t hashFrame(const CRGB *leds, uint16_t ledCount, uint8_t brightness)
+  {
+    uint32_t hash = 2166136261UL;
+    auto add = [&hash](uint8_t value)
+    {
+      hash ^= value;
+      hash *= 16777619UL;
+    };
+
+    add(brightness);
+    for (uint16_t i = 0; i < ledCount; ++i)
+    {
+      add(leds[i].r);
+      add(leds[i].g);
+      add(leds[i].b);
+    }
+    return hash;
+  }
+
+  //------------------------------------------------------------------------------
+
+  /** Sequence of per-frame hashes of an Animation, optionally with the raw frames.
+   * The hashes are stored as (diffable) text file; the raw frames go into a
+   * separate binary file with the same name plus ".frames" suffix.
+   */
+  struct GoldenFrames
+  {
+    /// Name of the recorded preset.
+    std::string preset;
+
+    /// Length of the LED strip.
+    uint16_t ledCount = 0;
+
+    /// Recorded duration of simulated time (in ms).
+    uint32_t durationMillis = 0;
+
+    /// Simulated time between two process() calls (in µs).
+    uint32_t tickMicros = 0;
+
+    /// Seed for random() and random8() & co.
+    uint16_t seed = 0;
+
+    /// Hash of every frame.
+    std::vector<uint32_t> hashes;
+
+    /// Raw RGB data of every frame (may be empty).
+    std::vector<uint8_t> frames;
+
+    /// Number of bytes per raw frame.
+    size_t frameSize() const { return size_t(ledCount) * 3; }
+
+    /// Check if the raw frames are available.
+    bool hasFrames() const { return !hashes.empty() && frames.size() == hashes.size() * frameSize(); }
+
+    /// Save to the given file; the raw frames are saved only if available.
+    bool save(const std::string &path) const
+    {
+      FILE *file = fopen(path.c_str(), "w");
+      if (!file)
+      {
+        return false;
+      }
+      fprintf(file, "# EyeCandy golden frames\n");
+      fprintf(file, "preset %s\nleds %u\nmillis %lu\ntick-us %lu\nseed %u\nframes %lu\n",
+              preset.c_str(), unsigned(ledCount), (unsigned long)durationMillis,
+              (unsigned long)tickMicros, unsigned(seed), (unsigned long)hashes.size());
+      for (const uint32_t hash : hashes)
+      {
+        fprintf(file, "%08lx\n", (unsigned long)hash);
+      }
+      bool success = (fclose(file) == 0);
+
+      if (success && hasFrames())
+      {
+        file = fopen((path + ".frames").c_str(), "wb");
+        success = file && fwrite(frames.data(), 1, frames.size(), file) == frames.size();
+        success = file && (fclose(file) == 0) && success;
+      }
+      return success;
+    }
+
+    /// Load from the given file, including the raw frames if available.
+    bool load(const std::string &path)
+    {
+      FILE *file = fopen(path.c_str(), "r");
+      if (!file)
+      {
+        return false;
+      }
+
+      char name[128] = {};
+      unsigned leds = 0, seedValue = 0;
+      unsigned long millisValue = 0, tickValue = 0, frameCount = 0;
+      bool success = fscanf(file, "# EyeCandy golden frames preset %127s leds %u millis %lu tick-us %lu seed %u frames %lu",
+                            name, &leds, &millisValue, &tickValue, &seedValue, &frameCount) == 6;
+      preset = name;
+      ledCount = uint16_t(leds);
+      durationMillis = millisValue;
+      tickMicros = tickValue;
+      seed = uint16_t(seedValue);
+
+      hashes.clear();
+      unsigned long hash = 0;
+      while (success && hashes.size() < frameCount && fscanf(file, "%lx", &hash) == 1)
+      {
+        hashes.push_back(uint32_t(hash));
+      }
+      success = success && hashes.size() == frameCount;
+      fclose(file);
+
+      frames.clear();
+      file = fopen((path + ".frames").c_str(), "rb");
+      if (file)
+      {
+        frames.resize(hashes.size() * frameSize());
+        frames.resize(fread(&frames[0], 1, frames.size(), file));
+        fclose(file);
+      }
+      return success;
+    }
+  };
+
+  //------------------------------------------------------------------------------
+
+  /// Captures all frames that are passed to FastLED.show() into GoldenFrames.
+  class GoldenFrameRecorder
+      : public CEmuFrameSink
+  {
+  public:
+    /** Constructor.
+     * @param golden  Record into this object.
+     * @param keepFrames  Record also the raw RGB data of every frame.
+     */
+    explicit GoldenFrameRecorder(GoldenFrames &golden, bool keepFrames = false)
+        : _golden(golden), _keepFrames(keepFrames)
+    {
+      FastLED.addFrameSink(*this);
+    }
+
+    ~GoldenFrameRecorder()
+    {
+      FastLED.removeFrameSink(*this);
+    }
+
+  private:
+    /// @see CEmuFrameSink::showFrame()
+    void showFrame(CLEDController &controller, uint8_t brightness) override
+    {
+      const CRGB *leds = controller.leds();
+      const uint16_t ledCount = uint16_t(controller.size());
+      _golden.hashes.push_back(hashFrame(leds, ledCount, brightness));
+      if (_keepFrames)
+      {
+        const uint8_t *raw = &leds[0].raw[0];
+        _golden.frames.insert(_golden.frames.end(), raw, raw + size_t(ledCount) * 3);
+      }
+    }
+
+    GoldenFrameRecorder(const GoldenFrameRecorder &) = delete;
+    GoldenFrameRecorder &operator=(const GoldenFrameRecorder &) = delete;
+
+    GoldenFrames &_golden;
+    bool _keepFrames;
+  };
+
+} // namespace EC
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,212 @@
+#pragma once
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+#ifndef ARDUINO_EMU
+#error "HeadlessRenderer.h is only available for the host build (intern/ArduinoEmu)"
+#endif
+
+#include <Animation.h>
+#include <FastLED.h>
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+namespace EC
+{
+
+  /// Results of a HeadlessRenderer run.
+  struct RenderStats
+  {
+    /// Rendered duration of simulated time (in ms).
+    uint32_t simulatedMillis = 0;
+
+    /// Number of process() calls.
+    uint32_t processCalls = 0;
+
+    /// Number of frames, i.e. process() calls that modified the LED strip.
+    uint32_t frames = 0;
+
+    /// Real time that the rendering took (in seconds).
+    double wallSeconds = 0.0;
+
+    /// Frames per second of simulated time.
+    double simulatedFps() const
+    {
+      return simulatedMillis ? frames * 1000.0 / simulatedMillis : 0.0;
+    }
+
+    /// Real time (in ns) per frame.
+    double nsPerFrame() const
+    {
+      return frames ? wallSeconds * 1e9 / frames : 0.0;
+    }
+
+    /// How much faster than real time the rendering was.
+    double speedup() const
+    {
+      return (wallSeconds > 0.0) ? simulatedMillis / (wallSeconds * 1000.0) : 0.0;
+    }
+
+    /// Print a summary to the given \a file.
+    void print(FILE *file = stdout) const
+    {
+      fprintf(file, "simulated: %.1f s, %lu process() calls, %lu frames (%.1f fps)\n",
+              simulatedMillis / 1000.0, (unsigned long)processCalls, (unsigned long)frames, simulatedFps());
+      fprintf(file, "wall-clock: %.3f s, %.0f ns/frame, %.0fx realtime\n",
+              wallSeconds, nsPerFrame(), speedup());
+    }
+  };
+
+  //------------------------------------------------------------------------------
+
+  /** Renders an Animation (like an AnimationScene or AnimationChanger) as fast
+   * as possible, using the simulated clock of the Arduino emulation.
+   * Every frame that modifies the LED strip is passed to FastLED.show(), so that
+   * it can be captured with a CFastLED::CEmuFrameSink.
+   */
+  class HeadlessRenderer
+  {
+  public:
+    /// Signature of the callbacks; gets the current (simulated) time in ms.
+    using Callback = std::function<void(uint32_t currentMillis)>;
+
+    /** Simulated time (in µs) between two process() calls.
+     * The default is close to the loop() rate of the example sketches on an Arduino Nano.
+     */
+    uint32_t tickMicros = 1000;
+
+    /// Call FastLED.show() for every frame that modified the LED strip.
+    bool showFrames = true;
+
+    /// When set, it is called instead of FastLED.show(), e.g. for testing an optimized output stage.
+    std::function<void()> showFunction;
+
+    /** Don't call process() until the next deadline that the Animation reports via
+     * getIdleMillis(), like a sketch that sleeps in between.
+     * onTick is still called on every tick, since the inputs don't sleep.
+     */
+    bool skipIdle = false;
+
+    /** Don't let the simulated time run ahead of the real time, e.g. for watching
+     * the frames with a CEmuTerminalPreview.
+     */
+    bool realtime = false;
+
+    /// Called before every process() call, e.g. for feeding (audio) input.
+    Callback onTick;
+
+    /// Called after every frame that modified the LED strip.
+    Callback onFrame;
+
+    /** When set, the real time (in ns) of every process() call that modified the
+     * LED strip is appended here.
+     */
+    std::vector<uint32_t> *frameNanos = nullptr;
+
+    /** Render the given \a animation for \a durationMillis of simulated time.
+     * Enables the simulated clock if not already active. Otherwise the simulated
+     * time just continues, so that multiple render() calls can be chained.
+     */
+    RenderStats render(Animation &animation, uint32_t durationMillis)
+    {
+      typedef std::chrono::steady_clock Clock;
+
+      if (!ArduinoEmu::isSimulatedClock())
+      {
+        ArduinoEmu::enableSimulatedClock();
+      }
+
+      RenderStats stats;
+      const uint64_t startMicros = ArduinoEmu::getSimulatedMicros();
+      const uint64_t endMicros = startMicros + uint64_t(durationMillis) * 1000;
+      const Clock::time_point wallStart = Clock::now();
+      uint64_t idleUntilMicros = 0;
+
+      while (ArduinoEmu::getSimulatedMicros() < endMicros)
+      {
+        const uint32_t currentMillis = millis();
+        if (onTick)
+        {
+          onTick(currentMillis);
+        }
+
+        if (ArduinoEmu::getSimulatedMicros() >= idleUntilMicros)
+        {
+          ++stats.processCalls;
+          const Clock::time_point processStart = frameNanos ? Clock::now() : Clock::time_point();
+          if (animation.process(currentMillis))
+          {
+            ++stats.frames;
+            if (frameNanos)
+            {
+              const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - processStart).count();
+              frameNanos->push_back(uint32_t(nanos));
+            }
+            if (showFrames)
+            {
+              if (showFunction)
+              {
+                showFunction();
+              }
+              else
+              {
+                FastLED.show();
+              }
+            }
+            if (onFrame)
+            {
+              onFrame(currentMillis);
+            }
+          }
+
+          if (skipIdle)
+          {
+            idleUntilMicros = ArduinoEmu::getSimulatedMicros() + uint64_t(animation.getIdleMillis(currentMillis)) * 1000;
+          }
+        }
+
+        ArduinoEmu::advanceSimulatedClock(tickMicros);
+        if (realtime)
+        {
+          std::this_thread::sleep_until(wallStart + std::chrono::microseconds(ArduinoEmu::getSimulatedMicros() - startMicros));
+        }
+      }
+
+      stats.simulatedMillis = uint32_t((ArduinoEmu::getSimulatedMicros() - startMicros) / 1000);
+      stats.wallSeconds = std::chrono::duration<double>(Clock::now() - wallStart).count();
+      return stats;
+    }
+  };
+
+} // namespace EC
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,105 @@
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+#include "HeapTracker.h"
+
+#include <cstdlib>
+#include <new>
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+  size_t currentBytes = 0;
+  size_t peakBytes = 0;
+  uint32_t allocationCount = 0;
+
+  /// Every allocation is prefixed with its size; keeps the maximum alignment.
+  union Header
+  {
+    size_t size;
+    max_align_t alignment;
+  };
+
+  void *allocate(size_t size)
+  {
+    Header *header = static_cast<Header *>(malloc(sizeof(Header) + size));
+    if (!header)
+    {
+      throw std::bad_alloc();
+    }
+    header->size = size;
+    currentBytes += size;
+    if (currentBytes > peakBytes)
+    {
+      peakBytes = currentBytes;
+    }
+    ++allocationCount;
+    return header + 1;
+  }
+
+  void deallocate(void *ptr)
+  {
+    if (ptr)
+    {
+      Header *header = static_cast<Header *>(ptr) - 1;
+      currentBytes -= header->size;
+      free(header);
+    }
+  }
+} // namespace
+
+//------------------------------------------------------------------------------
+
+size_t EC::HeapTracker::currentBytes() { return ::currentBytes; }
+size_t EC::HeapTracker::peakBytes() { return ::peakBytes; }
+void EC::HeapTracker::resetPeak() { ::peakBytes = ::currentBytes; }
+uint32_t EC::HeapTracker::allocationCount() { return ::allocationCount; }
+
+//------------------------------------------------------------------------------
+
+void *operator new(size_t size) { return allocate(size); }
+void *operator new[](size_t size) { return allocate(size); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+  try
+  {
+    return allocate(size);
+  }
+  catch (const std::bad_alloc &)
+  {
+    return nullptr;
+  }
+}
+void *operator new[](size_t size, const std::nothrow_t &tag) noexcept { return operator new(size, tag); }
+void operator delete(void *ptr) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, size_t) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { deallocate(ptr); }
+
+//------------------------------------------------------------------------------
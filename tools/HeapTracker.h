@@ -0,0 +1,60 @@
+#pragma once
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+
+namespace EC
+{
+
+  /** Statistics about heap allocations via new / delete.
+   * Only available in executables that are linked with HeapTracker.cpp, which
+   * replaces the global new & delete operators.
+   * @note All sizes are those of the host, which are usually larger than on an
+   * AVR (pointers, int, alignment).
+   */
+  namespace HeapTracker
+  {
+    /// Number of bytes that are currently allocated.
+    size_t currentBytes();
+
+    /// Maximum of currentBytes() since the last resetPeak().
+    size_t peakBytes();
+
+    /// Reset peakBytes() to currentBytes().
+    void resetPeak();
+
+    /// Total number of allocations since program start.
+    uint32_t allocationCount();
+
+  } // namespace HeapTracker
+
+} // namespace EC
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,240 @@
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+// Reports how often each preset calls the operations that are expensive on an
+// AVR (CHSV to CRGB conversions, noise, palettes, random numbers, blur and float
+// math), per frame. Multiplied with their cycle counts on the target, this gives
+// an estimate of the frame cost without hardware cycle counters.
+// VU presets are fed with a synthetic (but deterministic) audio signal, or with
+// the given audio file.
+//
+// Usage: OpCountReport [--csv] [--per-led] [--seconds N] [--leds N] [--audio FILE] [preset...]
+//   --csv          Machine-readable output (default: human readable table).
+//   --per-led      Report the counts per frame and per LED (default: per frame).
+//   --seconds N    Simulated time per preset (default: 30).
+//   --leds N       Length of the LED strip (default: 300).
+//   --audio FILE   Audio input for the VU presets (WAV or raw 16 bit PCM at 44.1 kHz);
+//                  default is a synthetic signal.
+//   preset...      Report only these presets (with or without "make_" prefix).
+//
+// The counts include all process() calls, also those that did not render a frame
+// (like the VU sources' sampling). Float operations are only counted in the
+// helpers from MathUtils.h.
+// When built with EC_TRACK_DIRTY_RANGE, the "dirty" column additionally shows
+// the span of LEDs that were written per frame.
+
+#include "HeadlessRenderer.h"
+#include "PresetCatalog.h"
+#include "SyntheticAudio.h"
+#include "VuAudioFile.h"
+
+#include <Animation_IO_config.h>
+#include <FastLED.h>
+
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+  /// Audio input for the VU presets; synthetic signal when empty.
+  EC::AudioFile audioFile;
+
+  EC::VuSource &makeVuSource(EC::SetupEnv &env)
+  {
+    if (!audioFile.samples.empty())
+    {
+      return env.add(new EC::VuAudioFile(audioFile));
+    }
+    return env.add(new EC::VuAnalogInputPin(PIN_MIC));
+  }
+
+  void feedMicrophone(uint32_t currentMillis)
+  {
+    EC::feedSyntheticAudio(currentMillis, PIN_MIC);
+  }
+
+  int usage(const char *program)
+  {
+    fprintf(stderr, "Usage: %s [--csv] [--per-led] [--seconds N] [--leds N] [--audio FILE] [preset...]\n", program);
+    return 1;
+  }
+} // namespace
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+  bool csv = false;
+  bool perLed = false;
+  uint32_t seconds = 30;
+  uint16_t ledCount = 300;
+  std::vector<const EC::PresetEntry *> presets;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const char *arg = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (strcmp(arg, "--csv") == 0)
+    {
+      csv = true;
+    }
+    else if (strcmp(arg, "--per-led") == 0)
+    {
+      perLed = true;
+    }
+    else if (strcmp(arg, "--seconds") == 0 && hasValue)
+    {
+      seconds = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(arg, "--leds") == 0 && hasValue)
+    {
+      ledCount = uint16_t(strtoul(argv[++i], nullptr, 10));
+    }
+    else if (strcmp(arg, "--audio") == 0 && hasValue)
+    {
+      if (!audioFile.load(argv[++i]))
+      {
+        fprintf(stderr, "Cannot load audio file %s\n", argv[i]);
+        return 1;
+      }
+    }
+    else if (arg[0] == '-')
+    {
+      return usage(argv[0]);
+    }
+    else
+    {
+      const EC::PresetEntry *preset = EC::findPreset(EC::allPatternPresets, arg);
+      if (!preset)
+      {
+        preset = EC::findPreset(EC::allVuPresets, arg);
+      }
+      if (!preset)
+      {
+        fprintf(stderr, "Unknown preset: %s\n", arg);
+        return 1;
+      }
+      presets.push_back(preset);
+    }
+  }
+  if (ledCount == 0 || ledCount > EC_PRESET_CATALOG_MAX_LEDS)
+  {
+    return usage(argv[0]);
+  }
+  if (presets.empty())
+  {
+    for (const EC::PresetEntry *catalog : {EC::allPatternPresets, EC::allVuPresets})
+    {
+      for (const EC::PresetEntry *preset = catalog; preset->maker; ++preset)
+      {
+        presets.push_back(preset);
+      }
+    }
+  }
+
+  std::vector<CRGB> leds(ledCount);
+  FastLED.addLeds<NEOPIXEL, LED_PIN>(leds.data(), ledCount);
+
+  EC::DirtyRange dirtyRange(leds.data());
+  EC::FastLedStrip strip(leds.data(), int16_t(ledCount));
+  strip.setDirtyRange(&dirtyRange);
+
+  EC::AnimationScene scene;
+  EC::SetupEnv setupEnv(strip, scene, &makeVuSource);
+
+  uint64_t dirtyLeds = 0;
+  EC::HeadlessRenderer renderer;
+  renderer.showFrames = false;
+  renderer.onFrame = [&](uint32_t)
+  {
+    dirtyLeds += dirtyRange.size();
+    dirtyRange.reset();
+  };
+  if (audioFile.samples.empty())
+  {
+    renderer.onTick = &feedMicrophone;
+  }
+  ArduinoEmu::enableSimulatedClock();
+
+  if (csv)
+  {
+    printf("preset,frames");
+    for (uint8_t op = 0; op < EmuOp_COUNT; ++op)
+    {
+      printf(",%s", emuOpName(EEmuOp(op)));
+    }
+    if (EC_TRACK_DIRTY_RANGE)
+    {
+      printf(",dirty");
+    }
+    printf("\n");
+  }
+  else
+  {
+    printf("Operations per frame%s, %u LEDs, %lu s per preset\n\n",
+           perLed ? " and LED" : "", unsigned(ledCount), (unsigned long)seconds);
+    printf("%-32s %8s", "preset", "frames");
+    for (uint8_t op = 0; op < EmuOp_COUNT; ++op)
+    {
+      printf(" %10.10s", emuOpName(EEmuOp(op)));
+    }
+    if (EC_TRACK_DIRTY_RANGE)
+    {
+      printf(" %10s", "dirty");
+    }
+    printf("\n");
+  }
+
+  for (const EC::PresetEntry *preset : presets)
+  {
+    // Same starting conditions for every preset
+    setupEnv.reset();
+    randomSeed(1);
+    random16_set_seed(1);
+    preset->maker(setupEnv);
+
+    FastLED.resetOpCounts();
+    dirtyLeds = 0;
+    dirtyRange.reset();
+    const EC::RenderStats stats = renderer.render(scene, seconds * 1000);
+    const double divisor = double(stats.frames ? stats.frames : 1) * (perLed ? ledCount : 1);
+
+    printf(csv ? "%s,%lu" : "%-32s %8lu", preset->name, (unsigned long)stats.frames);
+    for (uint8_t op = 0; op < EmuOp_COUNT; ++op)
+    {
+      printf(csv ? ",%.3f" : " %10.2f", FastLED.getOpCount(EEmuOp(op)) / divisor);
+    }
+    if (EC_TRACK_DIRTY_RANGE)
+    {
+      printf(csv ? ",%.3f" : " %10.2f", dirtyLeds / divisor);
+    }
+    printf("\n");
+  }
+  setupEnv.reset();
+  return 0;
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,169 @@
+#pragma once
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+/* Named lists of all presets from PatternPresets.h and VuPresets.h, plus
+ * make_Bubbles_Layered, which exists only for the tools.
+ * @note Like the preset headers themselves, include this file in only one
+ * translation unit per executable.
+ */
+
+#include <LayeredScene.h>
+#include <PatternPresets.h>
+#include <VuPresets.h>
+
+//------------------------------------------------------------------------------
+
+/** Maximum LED strip length for the Fire2012 based presets.
+ * They are templates with a fixed buffer size; the strip must not be longer.
+ */
+#ifndef EC_PRESET_CATALOG_MAX_LEDS
+#define EC_PRESET_CATALOG_MAX_LEDS 4096
+#endif
+
+//------------------------------------------------------------------------------
+
+/** Same as make_Bubbles(), but Pacifica is only rendered at its own update rate.
+ * Not part of PatternPresets.h, since the 2 extra layer buffers are too much for an AVR;
+ * it's here for covering LayeredScene by the tools (like the golden frames).
+ */
+inline void make_Bubbles_Layered(EC::SetupEnv &env)
+{
+  auto &layers = env.add(new EC::LayeredScene(env.strip()));
+  auto &ocean = layers.addLayer();
+  ocean.add(new EC::Pacifica(ocean.strip()));
+  ocean.add(new EC::BgFadeToBlack(ocean.strip(), true, 150));
+  auto &bubbles = layers.addLayer(EC::BlendMode::Max);
+  bubbles.add(new EC::Bubbles(bubbles.strip(), false));
+}
+
+//------------------------------------------------------------------------------
+
+namespace EC
+{
+
+  /// A preset function together with its name.
+  struct PresetEntry
+  {
+    const char *name;
+    AnimationSceneMakerFct maker;
+  };
+
+#define EC_PRESET_ENTRY(MAKER) {#MAKER, &MAKER}
+
+  /// All presets from PatternPresets.h, plus make_Bubbles_Layered; last entry is {nullptr, nullptr}
+  static const PresetEntry allPatternPresets[] = {
+      EC_PRESET_ENTRY(make_BallLightning),
+      EC_PRESET_ENTRY(make_Blur),
+      EC_PRESET_ENTRY(make_BouncingBalls),
+      EC_PRESET_ENTRY(make_Bubbles),
+      EC_PRESET_ENTRY(make_Bubbles_Layered),
+      EC_PRESET_ENTRY(make_ColorClouds),
+      EC_PRESET_ENTRY(make_ColorClouds_Ambient),
+      EC_PRESET_ENTRY(make_ColorClouds_ExtraSlow),
+      {"make_Fire", &make_Fire<EC_PRESET_CATALOG_MAX_LEDS>},
+      EC_PRESET_ENTRY(make_Fireworks),
+      {"make_Flare", &make_Flare<EC_PRESET_CATALOG_MAX_LEDS>},
+      EC_PRESET_ENTRY(make_FloatingBlobs),
+      EC_PRESET_ENTRY(make_KITT),
+      EC_PRESET_ENTRY(make_Lavalamp),
+      EC_PRESET_ENTRY(make_MeteorGlitter),
+      EC_PRESET_ENTRY(make_UnicornMeteor),
+      EC_PRESET_ENTRY(make_Pacifica),
+      EC_PRESET_ENTRY(make_Pride),
+      EC_PRESET_ENTRY(make_PrideMirror),
+      EC_PRESET_ENTRY(make_Rainbow),
+      EC_PRESET_ENTRY(make_RainbowBuiltin),
+      EC_PRESET_ENTRY(make_RainbowDrips),
+      EC_PRESET_ENTRY(make_RainbowTwinkle),
+      EC_PRESET_ENTRY(make_RetroPartyLight),
+      EC_PRESET_ENTRY(make_RgbBlocks),
+      EC_PRESET_ENTRY(make_Twinkles),
+      EC_PRESET_ENTRY(make_Waterfall),
+      {nullptr, nullptr}};
+
+  /// All presets from VuPresets.h; last entry is {nullptr, nullptr}
+  static const PresetEntry allVuPresets[] = {
+      EC_PRESET_ENTRY(make_BallLightningVU),
+      EC_PRESET_ENTRY(make_BeyondCrazyVU),
+      EC_PRESET_ENTRY(make_BeyondCrazyVU_inward),
+      EC_PRESET_ENTRY(make_BeyondCrazyVU_outward),
+      EC_PRESET_ENTRY(make_BlackHoleVU),
+      EC_PRESET_ENTRY(make_BlackAntiHoleVU),
+      EC_PRESET_ENTRY(make_CrazyVU),
+      EC_PRESET_ENTRY(make_CrazyVU_inward),
+      EC_PRESET_ENTRY(make_CrazyVU_outward),
+      EC_PRESET_ENTRY(make_DancingJellyfishVU),
+      EC_PRESET_ENTRY(make_DancingDotVU),
+      EC_PRESET_ENTRY(make_DoubleDancingDotVU1),
+      EC_PRESET_ENTRY(make_DoubleDancingDotVU2),
+      EC_PRESET_ENTRY(make_EjectingDotVU),
+      EC_PRESET_ENTRY(make_EjectingDotVU_inward),
+      EC_PRESET_ENTRY(make_EjectingDotVU_outward),
+      {"make_FireVU", &make_FireVU<EC_PRESET_CATALOG_MAX_LEDS>},
+      {"make_FlareVU", &make_FlareVU<EC_PRESET_CATALOG_MAX_LEDS>},
+      {"make_FlareDoubleVU", &make_FlareDoubleVU<EC_PRESET_CATALOG_MAX_LEDS>},
+      {"make_FlareInwardVU", &make_FlareInwardVU<EC_PRESET_CATALOG_MAX_LEDS>},
+      EC_PRESET_ENTRY(make_FlowingBeatVU),
+      EC_PRESET_ENTRY(make_FlowingBeatVU_inward),
+      EC_PRESET_ENTRY(make_FlowingBeatVU_outward),
+      EC_PRESET_ENTRY(make_FranticVU),
+      EC_PRESET_ENTRY(make_FranticVU_inward),
+      EC_PRESET_ENTRY(make_FranticVU_outward),
+      EC_PRESET_ENTRY(make_LightbulbVU),
+      EC_PRESET_ENTRY(make_MeteorTrailVU),
+      EC_PRESET_ENTRY(make_PeakGlitterVU),
+      EC_PRESET_ENTRY(make_PeakMothsVU),
+      EC_PRESET_ENTRY(make_RainbowBallVU),
+      EC_PRESET_ENTRY(make_RainbowBalllVU_inward),
+      EC_PRESET_ENTRY(make_RainbowBalllVU_outward),
+      EC_PRESET_ENTRY(make_RainbowBubbleVU),
+      EC_PRESET_ENTRY(make_RainbowBubbleVU_inward),
+      EC_PRESET_ENTRY(make_RainbowBubbleVU_outward),
+      EC_PRESET_ENTRY(make_RainingVU),
+      EC_PRESET_ENTRY(make_RainingVU_inward),
+      EC_PRESET_ENTRY(make_RainingVU_outward),
+      EC_PRESET_ENTRY(make_RetroPartyVU),
+      {nullptr, nullptr}};
+
+#undef EC_PRESET_ENTRY
+
+  /// Find the preset with the given \a name in the given \a presets (or NULL).
+  inline const PresetEntry *findPreset(const PresetEntry presets[], const char *name)
+  {
+    for (; presets->maker; ++presets)
+    {
+      if (strcmp(presets->name, name) == 0 || strcmp(presets->name + 5, name) == 0)
+      {
+        return presets;
+      }
+    }
+    return nullptr;
+  }
+
+} // namespace EC
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,262 @@
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+// Ranks all presets from PatternPresets.h and VuPresets.h by their render time
+// per frame, to see which of them can hold the desired frame rate.
+// VU presets are fed with a synthetic (but deterministic) audio signal, or with
+// the given audio file.
+//
+// Usage: PresetRanking [--csv] [--seconds N] [--leds N] [--budget-us N] [--slowdown F] [--audio FILE] [preset...]
+//   --csv          Machine-readable output (default: human readable table).
+//   --seconds N    Simulated time per preset (default: 30).
+//   --leds N       Length of the LED strip (default: 300).
+//   --budget-us N  Available time per frame (default: EC_DEFAULT_UPDATE_PERIOD).
+//   --slowdown F   How much slower the target controller is than this host
+//                  (default: 1.0); applied to all times before checking the budget.
+//   --audio FILE   Audio input for the VU presets (WAV or raw 16 bit PCM at 44.1 kHz);
+//                  default is a synthetic signal.
+//   preset...      Rank only these presets (with or without "make_" prefix).
+//
+// Heap sizes are those of the host. The Fire2012 based presets are instantiated
+// for EC_PRESET_CATALOG_MAX_LEDS, so their heap usage is larger than in a sketch.
+
+#include "HeadlessRenderer.h"
+#include "HeapTracker.h"
+#include "PresetCatalog.h"
+#include "SyntheticAudio.h"
+#include "VuAudioFile.h"
+
+#include <Animation_IO_config.h>
+#include <FastLED.h>
+
+#include <algorithm>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+  struct Ranking
+  {
+    const char *name;
+    uint32_t frames;
+    double meanMicros;
+    double p99Micros;
+    double maxMicros;
+    size_t heapBytes;
+    size_t peakHeapBytes;
+  };
+
+  /// Audio input for the VU presets; synthetic signal when empty.
+  EC::AudioFile audioFile;
+
+  EC::VuSource &makeVuSource(EC::SetupEnv &env)
+  {
+    if (!audioFile.samples.empty())
+    {
+      return env.add(new EC::VuAudioFile(audioFile));
+    }
+    return env.add(new EC::VuAnalogInputPin(PIN_MIC));
+  }
+
+  void feedMicrophone(uint32_t currentMillis)
+  {
+    EC::feedSyntheticAudio(currentMillis, PIN_MIC);
+  }
+
+  /// Evaluate the frame times (in ns) of one preset; \a frameNanos gets sorted.
+  void evaluate(Ranking &ranking, std::vector<uint32_t> &frameNanos, double slowdown)
+  {
+    ranking.frames = frameNanos.size();
+    if (frameNanos.empty())
+    {
+      return;
+    }
+
+    std::sort(frameNanos.begin(), frameNanos.end());
+    double sum = 0.0;
+    for (const uint32_t nanos : frameNanos)
+    {
+      sum += nanos;
+    }
+    const size_t p99Index = (frameNanos.size() * 99 + 99) / 100 - 1;
+    ranking.meanMicros = sum / frameNanos.size() / 1000.0 * slowdown;
+    ranking.p99Micros = frameNanos[p99Index] / 1000.0 * slowdown;
+    ranking.maxMicros = frameNanos.back() / 1000.0 * slowdown;
+  }
+
+  int usage(const char *program)
+  {
+    fprintf(stderr, "Usage: %s [--csv] [--seconds N] [--leds N] [--budget-us N] [--slowdown F] [--audio FILE] [preset...]\n", program);
+    return 1;
+  }
+} // namespace
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+  bool csv = false;
+  uint32_t seconds = 30;
+  uint16_t ledCount = 300;
+  uint32_t budgetMicros = EC_DEFAULT_UPDATE_PERIOD * 1000UL;
+  double slowdown = 1.0;
+  std::vector<const EC::PresetEntry *> presets;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const char *arg = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (strcmp(arg, "--csv") == 0)
+    {
+      csv = true;
+    }
+    else if (strcmp(arg, "--seconds") == 0 && hasValue)
+    {
+      seconds = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(arg, "--leds") == 0 && hasValue)
+    {
+      ledCount = uint16_t(strtoul(argv[++i], nullptr, 10));
+    }
+    else if (strcmp(arg, "--budget-us") == 0 && hasValue)
+    {
+      budgetMicros = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(arg, "--slowdown") == 0 && hasValue)
+    {
+      slowdown = strtod(argv[++i], nullptr);
+    }
+    else if (strcmp(arg, "--audio") == 0 && hasValue)
+    {
+      if (!audioFile.load(argv[++i]))
+      {
+        fprintf(stderr, "Cannot load audio file %s\n", argv[i]);
+        return 1;
+      }
+    }
+    else if (arg[0] == '-')
+    {
+      return usage(argv[0]);
+    }
+    else
+    {
+      const EC::PresetEntry *preset = EC::findPreset(EC::allPatternPresets, arg);
+      if (!preset)
+      {
+        preset = EC::findPreset(EC::allVuPresets, arg);
+      }
+      if (!preset)
+      {
+        fprintf(stderr, "Unknown preset: %s\n", arg);
+        return 1;
+      }
+      presets.push_back(preset);
+    }
+  }
+  if (ledCount == 0 || ledCount > EC_PRESET_CATALOG_MAX_LEDS || slowdown <= 0.0)
+  {
+    return usage(argv[0]);
+  }
+  if (presets.empty())
+  {
+    for (const EC::PresetEntry *catalog : {EC::allPatternPresets, EC::allVuPresets})
+    {
+      for (const EC::PresetEntry *preset = catalog; preset->maker; ++preset)
+      {
+        presets.push_back(preset);
+      }
+    }
+  }
+
+  std::vector<CRGB> leds(ledCount);
+  FastLED.addLeds<NEOPIXEL, LED_PIN>(leds.data(), ledCount);
+
+  EC::AnimationScene scene;
+  EC::SetupEnv setupEnv({leds.data(), int16_t(ledCount)}, scene, &makeVuSource);
+
+  std::vector<uint32_t> frameNanos;
+  frameNanos.reserve(seconds * 1000UL);
+  EC::HeadlessRenderer renderer;
+  if (audioFile.samples.empty())
+  {
+    renderer.onTick = &feedMicrophone;
+  }
+  renderer.frameNanos = &frameNanos;
+  ArduinoEmu::enableSimulatedClock();
+
+  std::vector<Ranking> rankings;
+  for (const EC::PresetEntry *preset : presets)
+  {
+    // Same starting conditions for every preset
+    setupEnv.reset();
+    randomSeed(1);
+    random16_set_seed(1);
+    frameNanos.clear();
+
+    Ranking ranking = {preset->name, 0, 0.0, 0.0, 0.0, 0, 0};
+    const size_t heapBefore = EC::HeapTracker::currentBytes();
+    preset->maker(setupEnv);
+    ranking.heapBytes = EC::HeapTracker::currentBytes() - heapBefore;
+
+    EC::HeapTracker::resetPeak();
+    renderer.render(scene, seconds * 1000);
+    ranking.peakHeapBytes = EC::HeapTracker::peakBytes() - heapBefore;
+
+    evaluate(ranking, frameNanos, slowdown);
+    rankings.push_back(ranking);
+  }
+  setupEnv.reset();
+
+  std::sort(rankings.begin(), rankings.end(), [](const Ranking &lhs, const Ranking &rhs)
+            { return lhs.p99Micros > rhs.p99Micros; });
+
+  if (csv)
+  {
+    printf("rank,preset,frames,mean_us,p99_us,max_us,heap_bytes,peak_heap_bytes,fits_budget\n");
+  }
+  else
+  {
+    printf("Budget: %lu us per frame, slowdown %.2f, %u LEDs, %lu s per preset\n\n",
+           (unsigned long)budgetMicros, slowdown, unsigned(ledCount), (unsigned long)seconds);
+    printf("%4s %-32s %8s %10s %10s %10s %8s %8s %s\n",
+           "rank", "preset", "frames", "mean us", "p99 us", "max us", "heap", "peak", "fits");
+  }
+  uint16_t rank = 0;
+  for (const Ranking &ranking : rankings)
+  {
+    const bool fits = ranking.p99Micros <= budgetMicros;
+    printf(csv ? "%u,%s,%lu,%.2f,%.2f,%.2f,%lu,%lu,%s\n"
+               : "%4u %-32s %8lu %10.2f %10.2f %10.2f %8lu %8lu %s\n",
+           unsigned(++rank), ranking.name, (unsigned long)ranking.frames,
+           ranking.meanMicros, ranking.p99Micros, ranking.maxMicros,
+           (unsigned long)ranking.heapBytes, (unsigned long)ranking.peakHeapBytes,
+           fits ? "yes" : "NO");
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,250 @@
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+// Renders presets from PatternPresets.h / VuPresets.h with a simulated clock,
+// as fast as possible, and reports the frame rate and the wall-clock cost.
+//
+// Usage: RenderPresets [--vu] [--preview] [--realtime] [--truncated] [--skip-idle] [--seconds N] [--leds N] [--tick-us N] [--audio FILE] [preset...]
+//   --vu          Use the VU presets (default: pattern presets).
+//   --preview     Draw the LED strip to the terminal (on stderr, max. 30 fps).
+//   --realtime    Render in real time instead of as fast as possible.
+//   --truncated   Show the frames via EC::TruncatedShow.
+//   --skip-idle   Don't call process() while the scene reports to be idle.
+//   --seconds N   Simulated time per preset (default: 60).
+//   --leds N      Length of the LED strip (default: 300).
+//   --tick-us N   Simulated time between two process() calls (default: 1000).
+//   --audio FILE  Audio input for the VU presets (WAV or raw 16 bit PCM at 44.1 kHz);
+//                 default is a synthetic signal.
+//   preset...     Render only these presets (with or without "make_" prefix).
+
+#include "HeadlessRenderer.h"
+#include "PresetCatalog.h"
+#include "SyntheticAudio.h"
+#include "VuAudioFile.h"
+
+#include <Animation_IO_config.h>
+#include <FastLED.h>
+#include <TerminalPreview.h>
+#include <TruncatedShow.h>
+
+#include <memory>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+  /// Audio input for the VU presets; synthetic signal when empty.
+  EC::AudioFile audioFile;
+
+  EC::VuSource &makeVuSource(EC::SetupEnv &env)
+  {
+    if (!audioFile.samples.empty())
+    {
+      return env.add(new EC::VuAudioFile(audioFile));
+    }
+    return env.add(new EC::VuAnalogInputPin(PIN_MIC));
+  }
+
+  void feedMicrophone(uint32_t currentMillis)
+  {
+    EC::feedSyntheticAudio(currentMillis, PIN_MIC);
+  }
+
+  /// Options without value.
+  bool isFlag(const char *arg)
+  {
+    return strcmp(arg, "--vu") == 0 || strcmp(arg, "--preview") == 0 ||
+           strcmp(arg, "--realtime") == 0 || strcmp(arg, "--truncated") == 0 ||
+           strcmp(arg, "--skip-idle") == 0;
+  }
+
+  int usage(const char *program)
+  {
+    fprintf(stderr, "Usage: %s [--vu] [--preview] [--realtime] [--truncated] [--skip-idle] [--seconds N] [--leds N] [--tick-us N] [--audio FILE] [preset...]\n", program);
+    return 1;
+  }
+} // namespace
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+  const EC::PresetEntry *catalog = EC::allPatternPresets;
+  uint32_t seconds = 60;
+  uint16_t ledCount = 300;
+  uint32_t tickMicros = 1000;
+  bool preview = false;
+  bool realtime = false;
+  bool truncated = false;
+  bool skipIdle = false;
+  std::vector<const EC::PresetEntry *> presets;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const char *arg = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (strcmp(arg, "--vu") == 0)
+    {
+      catalog = EC::allVuPresets;
+    }
+    else if (strcmp(arg, "--preview") == 0)
+    {
+      preview = true;
+    }
+    else if (strcmp(arg, "--realtime") == 0)
+    {
+      realtime = true;
+    }
+    else if (strcmp(arg, "--truncated") == 0)
+    {
+      truncated = true;
+    }
+    else if (strcmp(arg, "--skip-idle") == 0)
+    {
+      skipIdle = true;
+    }
+    else if (strcmp(arg, "--seconds") == 0 && hasValue)
+    {
+      seconds = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(arg, "--leds") == 0 && hasValue)
+    {
+      ledCount = uint16_t(strtoul(argv[++i], nullptr, 10));
+    }
+    else if (strcmp(arg, "--tick-us") == 0 && hasValue)
+    {
+      tickMicros = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(arg, "--audio") == 0 && hasValue)
+    {
+      if (!audioFile.load(argv[++i]))
+      {
+        fprintf(stderr, "Cannot load audio file %s\n", argv[i]);
+        return 1;
+      }
+    }
+    else if (arg[0] == '-')
+    {
+      return usage(argv[0]);
+    }
+  }
+
+  // Presets are resolved after all options, so that --vu may come last.
+  for (int i = 1; i < argc; ++i)
+  {
+    const char *arg = argv[i];
+    if (arg[0] == '-')
+    {
+      if (!isFlag(arg))
+      {
+        ++i;
+      }
+      continue;
+    }
+    const EC::PresetEntry *preset = EC::findPreset(catalog, arg);
+    if (!preset)
+    {
+      fprintf(stderr, "Unknown preset: %s\n", arg);
+      return 1;
+    }
+    presets.push_back(preset);
+  }
+  if (presets.empty())
+  {
+    for (const EC::PresetEntry *preset = catalog; preset->maker; ++preset)
+    {
+      presets.push_back(preset);
+    }
+  }
+  if (ledCount == 0 || ledCount > EC_PRESET_CATALOG_MAX_LEDS || tickMicros == 0)
+  {
+    return usage(argv[0]);
+  }
+
+  std::vector<CRGB> leds(ledCount);
+  CLEDController &controller = FastLED.addLeds<NEOPIXEL, LED_PIN>(leds.data(), ledCount);
+  std::unique_ptr<EC::TruncatedShow<EC_PRESET_CATALOG_MAX_LEDS>> truncatedShow(
+      new EC::TruncatedShow<EC_PRESET_CATALOG_MAX_LEDS>(controller));
+
+  EC::AnimationScene scene;
+  EC::SetupEnv setupEnv({leds.data(), int16_t(ledCount)}, scene, &makeVuSource);
+
+  EC::HeadlessRenderer renderer;
+  renderer.tickMicros = tickMicros;
+  renderer.realtime = realtime;
+  renderer.skipIdle = skipIdle;
+  if (truncated)
+  {
+    renderer.showFunction = [&truncatedShow]()
+    { truncatedShow->show(); };
+  }
+  if (audioFile.samples.empty())
+  {
+    renderer.onTick = &feedMicrophone;
+  }
+
+  randomSeed(1);
+  random16_set_seed(1);
+  ArduinoEmu::enableSimulatedClock();
+
+  CEmuTerminalPreview terminalPreview(stderr);
+  if (preview)
+  {
+    terminalPreview.attach();
+  }
+
+  EC::RenderStats total;
+  printf("%-32s %10s %10s %12s %10s %10s\n", "preset", "frames", "fps", "ns/frame", "speedup", "tx/frame");
+  fflush(stdout);
+  for (const EC::PresetEntry *preset : presets)
+  {
+    setupEnv.reset();
+    preset->maker(setupEnv);
+    truncatedShow->invalidate();
+
+    const uint64_t transmittedBefore = FastLED.getTransmittedLedCount();
+    const EC::RenderStats stats = renderer.render(scene, seconds * 1000);
+    const uint64_t transmitted = FastLED.getTransmittedLedCount() - transmittedBefore;
+    printf("%-32s %10lu %10.1f %12.0f %9.0fx %10.1f\n", preset->name,
+           (unsigned long)stats.frames, stats.simulatedFps(), stats.nsPerFrame(), stats.speedup(),
+           stats.frames ? double(transmitted) / stats.frames : 0.0);
+    fflush(stdout);
+    terminalPreview.restart();
+
+    total.simulatedMillis += stats.simulatedMillis;
+    total.processCalls += stats.processCalls;
+    total.frames += stats.frames;
+    total.wallSeconds += stats.wallSeconds;
+  }
+  scene.reset();
+
+  printf("\n");
+  total.print(stdout);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,329 @@
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+// Micro-benchmarks for the FastLedStrip primitives and color helpers, measured
+// at different strip lengths to see which of them scale badly.
+//
+// Usage: StripBenchmark [--csv | --json] [--min-ms N] [--leds N,N,...] [filter]
+//   --csv / --json  Machine-readable output (default: human readable table).
+//   --min-ms N      Minimum duration of one measurement (default: 20).
+//   --leds N,...    Strip lengths (default: 60,300,1024,4096).
+//   filter          Run only the benchmarks whose name contains this text.
+
+#include "Benchmark.h"
+
+#include <FastLedStrip.h>
+
+#include <cstring>
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+  /// Prevents the compiler from optimizing away results that are not stored in the LED strip.
+  volatile uint32_t resultSink;
+
+  /// Fill the strip with random colors, so that all benchmarks start from the same non-trivial content.
+  void randomizeStrip(std::vector<CRGB> &leds)
+  {
+    random16_set_seed(1337);
+    for (auto &pixel : leds)
+    {
+      pixel = CRGB(random8(), random8(), random8());
+    }
+  }
+
+  void runAll(EC::BenchmarkRunner &runner, uint16_t ledCount, const char *filter)
+  {
+    std::vector<CRGB> leds(ledCount);
+    EC::FastLedStrip strip(leds.data(), int16_t(ledCount));
+    auto prepare = [&leds]
+    { randomizeStrip(leds); };
+    auto enabled = [filter](const char *name)
+    { return !filter || strstr(name, filter); };
+
+    // FastLedStrip primitives
+
+    if (enabled("fill"))
+    {
+      runner.run("fill", ledCount, [&](uint32_t i)
+                 { strip.fill(CRGB(uint8_t(i), 0x55, 0xAA)); },
+                 prepare);
+      runner.run("fill(scalar)", ledCount, [&](uint32_t i)
+                 { EC::PixelKernels::Scalar::fill(leds.data(), ledCount, CRGB(uint8_t(i), 0x55, 0xAA)); },
+                 prepare);
+    }
+    if (enabled("lineAbs"))
+    {
+      runner.run("lineAbs", ledCount, [&](uint32_t i)
+                 { strip.lineAbs(ledCount / 4, ledCount * 3 / 4, CRGB(uint8_t(i), 0x55, 0xAA)); },
+                 prepare);
+    }
+    if (enabled("q_lineAA"))
+    {
+      runner.run("q_lineAA", ledCount, [&](uint32_t i)
+                 { strip.q_lineAA(EC::npos_t(i & 0xFF) << 8, (EC::npos_t(i & 0xFF) << 8) + EC::NPOS_ONE / 4, CRGB(uint8_t(i), 0x55, 0xAA)); },
+                 prepare);
+    }
+    if (enabled("shift"))
+    {
+      runner.run("shift(1)", ledCount, [&](uint32_t i)
+                 { strip.shift(1, CRGB(uint8_t(i), 0, 0)); },
+                 prepare);
+      runner.run("shift(7)", ledCount, [&](uint32_t i)
+                 { strip.shift(7, CRGB(uint8_t(i), 0, 0)); },
+                 prepare);
+      runner.run("shift(-7)", ledCount, [&](uint32_t i)
+                 { strip.shift(-7, CRGB(uint8_t(i), 0, 0)); },
+                 prepare);
+    }
+    if (enabled("rotate"))
+    {
+      runner.run("rotate(1)", ledCount, [&](uint32_t)
+                 { strip.rotate(1); },
+                 prepare);
+      runner.run("rotate(7)", ledCount, [&](uint32_t)
+                 { strip.rotate(7); },
+                 prepare);
+      runner.run("rotate(-7)", ledCount, [&](uint32_t)
+                 { strip.rotate(-7); },
+                 prepare);
+    }
+    if (enabled("copyUp"))
+    {
+      runner.run("copyUp", ledCount, [&](uint32_t)
+                 { strip.copyUp(false); },
+                 prepare);
+      runner.run("copyUp(mirrored)", ledCount, [&](uint32_t)
+                 { strip.copyUp(true); },
+                 prepare);
+    }
+    if (enabled("blur"))
+    {
+      runner.run("blur", ledCount, [&](uint32_t)
+                 { strip.blur(64); },
+                 prepare);
+      runner.run("blur(cycles=4)", ledCount, [&](uint32_t)
+                 { strip.blur(64, 4); },
+                 prepare);
+    }
+    if (enabled("fadeToBlack"))
+    {
+      runner.run("fadeToBlack", ledCount, [&](uint32_t)
+                 { strip.fadeToBlack(32); },
+                 prepare);
+      // FastLED's implementation, as reference for the PixelKernels
+      runner.run("fadeToBlackBy", ledCount, [&](uint32_t)
+                 { fadeToBlackBy(leds.data(), ledCount, 32); },
+                 prepare);
+    }
+    if (enabled("add"))
+    {
+      std::vector<CRGB> other(ledCount, CRGB(0x10, 0x40, 0x80));
+      runner.run("PixelKernels::add", ledCount, [&](uint32_t)
+                 { EC::PixelKernels::add(leds.data(), other.data(), ledCount); },
+                 prepare);
+      runner.run("CRGB::operator+=", ledCount, [&](uint32_t)
+                 { for (uint16_t k = 0; k < ledCount; ++k)
+                   {
+                     leds[k] += other[k];
+                   } },
+                 prepare);
+    }
+    if (enabled("maxChannels"))
+    {
+      std::vector<CRGB> other(ledCount, CRGB(0x10, 0x40, 0x80));
+      runner.run("PixelKernels::maxChannels", ledCount, [&](uint32_t)
+                 { EC::PixelKernels::maxChannels(leds.data(), other.data(), ledCount); },
+                 prepare);
+    }
+    if (enabled("pixels"))
+    {
+      // Per-pixel access on a reversed strip, like the Rainbow or Fire2012 loops.
+      EC::FastLedStrip reversed = strip.getReversedStrip();
+      runner.run("operator[] (all pixels)", ledCount, [&](uint32_t i)
+                 {
+                   for (int16_t k = 0; k < int16_t(ledCount); ++k)
+                   {
+                     reversed[k] = CRGB(uint8_t(i + k), 0, 0);
+                   } },
+                 prepare);
+      runner.run("pixels() (all pixels)", ledCount, [&](uint32_t i)
+                 {
+                   uint8_t k = 0;
+                   for (auto &pixel : reversed.pixels())
+                   {
+                     pixel = CRGB(uint8_t(i + k++), 0, 0);
+                   } },
+                 prepare);
+    }
+    if (enabled("n_pixel"))
+    {
+      // One call per LED, so that the result is comparable with the other per-strip operations.
+      runner.run("n_pixel", ledCount, [&](uint32_t i)
+                 {
+                   const float step = 1.0 / ledCount;
+                   for (uint16_t k = 0; k < ledCount; ++k)
+                   {
+                     strip.n_pixel(k * step) = CRGB(uint8_t(i + k), 0, 0);
+                   } },
+                 prepare);
+    }
+    if (enabled("getSubStrip"))
+    {
+      runner.run("getSubStrip", ledCount, [&](uint32_t i)
+                 {
+                   EC::FastLedStrip subStrip = strip.getSubStrip(int16_t(i % ledCount), int16_t(ledCount / 2), i & 1);
+                   resultSink = resultSink + uint32_t(subStrip.ledCount()); });
+    }
+
+    // Color helpers
+
+    if (enabled("ColorWheel::getColor"))
+    {
+      EC::ColorWheel wheel;
+      runner.run("ColorWheel::getColor", ledCount, [&](uint32_t)
+                 {
+                   wheel.update();
+                   const float step = 1.0 / ledCount;
+                   for (uint16_t k = 0; k < ledCount; ++k)
+                   {
+                     leds[k] = wheel.getColor(k * step);
+                   } });
+    }
+    if (enabled("redShift"))
+    {
+      runner.run("redShift", ledCount, [&](uint32_t i)
+                 {
+                   uint32_t sum = 0;
+                   for (uint16_t k = 0; k < ledCount; ++k)
+                   {
+                     sum += EC::redShift(uint8_t(i + k));
+                   }
+                   resultSink = sum; });
+    }
+    if (enabled("CHSV"))
+    {
+      runner.run("CHSV", ledCount, [&](uint32_t i)
+                 {
+                   for (uint16_t k = 0; k < ledCount; ++k)
+                   {
+                     leds[k] = CHSV(uint8_t(i + k), 240, 255);
+                   } });
+    }
+    if (enabled("meteorFadeToBlack"))
+    {
+      runner.run("meteorFadeToBlack", ledCount, [&](uint32_t)
+                 { EC::meteorFadeToBlack(strip, 32, 96); },
+                 prepare);
+    }
+  }
+
+  int usage(const char *program)
+  {
+    fprintf(stderr, "Usage: %s [--csv | --json] [--min-ms N] [--leds N,N,...] [filter]\n", program);
+    return 1;
+  }
+} // namespace
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+  enum
+  {
+    Table,
+    Csv,
+    Json
+  } format = Table;
+  std::vector<uint16_t> ledCounts = {60, 300, 1024, 4096};
+  const char *filter = nullptr;
+  EC::BenchmarkRunner runner;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const char *arg = argv[i];
+    const bool hasValue = (i + 1 < argc);
+    if (strcmp(arg, "--csv") == 0)
+    {
+      format = Csv;
+    }
+    else if (strcmp(arg, "--json") == 0)
+    {
+      format = Json;
+    }
+    else if (strcmp(arg, "--min-ms") == 0 && hasValue)
+    {
+      runner.minMillis = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(arg, "--leds") == 0 && hasValue)
+    {
+      ledCounts.clear();
+      for (char *list = argv[++i]; *list;)
+      {
+        const unsigned long ledCount = strtoul(list, &list, 10);
+        if (ledCount == 0 || ledCount > 0x7FFF)
+        {
+          return usage(argv[0]);
+        }
+        ledCounts.push_back(uint16_t(ledCount));
+        if (*list == ',')
+        {
+          ++list;
+        }
+      }
+    }
+    else if (arg[0] == '-' || filter)
+    {
+      return usage(argv[0]);
+    }
+    else
+    {
+      filter = arg;
+    }
+  }
+
+  for (const uint16_t ledCount : ledCounts)
+  {
+    runAll(runner, ledCount, filter);
+  }
+
+  switch (format)
+  {
+  case Csv:
+    runner.printCsv(stdout);
+    break;
+  case Json:
+    runner.printJson(stdout);
+    break;
+  default:
+    runner.printTable(stdout);
+    break;
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,55 @@
+#pragma once
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+#ifndef ARDUINO_EMU
+#error "SyntheticAudio.h is only available for the host build (intern/ArduinoEmu)"
+#endif
+
+#include <Arduino.h>
+
+//------------------------------------------------------------------------------
+
+namespace EC
+{
+
+  /** Feed a synthetic microphone signal into the emulated analog input \a pin.
+   * Noise with a beat at 120 BPM; deterministic for a given randomSeed().
+   * Intended as HeadlessRenderer::onTick callback for VU Animations.
+   * @param currentMillis  Current (simulated) time.
+   * @param pin  Analog input pin of the microphone.
+   */
+  inline void feedSyntheticAudio(uint32_t currentMillis, uint8_t pin)
+  {
+    const uint16_t beatPhase = currentMillis % 500;
+    const uint16_t amplitude = (beatPhase < 250) ? 400 - beatPhase * 3 / 2 : 25;
+    const int16_t sample = int16_t(random(-int32_t(amplitude), int32_t(amplitude) + 1));
+    ArduinoEmu::setAnalogInput(pin, uint16_t(512 + sample));
+  }
+
+} // namespace EC
+
+//------------------------------------------------------------------------------
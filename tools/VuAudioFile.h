@@ -0,0 +1,313 @@
+#pragma once
+/*******************************************************************************
+
+MIT License
+
+Copyright (c) 2024 Joachim Dick
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*******************************************************************************/
+
+#ifndef ARDUINO_EMU
+#error "VuAudioFile.h is only available for the host build (intern/ArduinoEmu)"
+#endif
+
+#include <Animation.h>
+#include <AudioNormalizer.h>
+#include <VuLevelHandler.h>
+#include <VuRangeExtender.h>
+#include <VuSource.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+namespace EC
+{
+
+  /** Audio samples from a WAV file (PCM 8/16/24/32 bit or 32 bit float) or from a
+   * raw PCM file (signed 16 bit, little endian). Multiple channels are mixed to mono.
+   */
+  class AudioFile
+  {
+  public:
+    /// All samples (mono).
+    std::vector<int16_t> samples;
+
+    /// Samples per second.
+    uint32_t sampleRate = 0;
+
+    /// Repeat the audio from the start when reaching the end.
+    bool loop = true;
+
+    /** Load a WAV file.
+     * @return \c false when the file can't be read or has an unsupported format.
+     */
+    bool loadWav(const std::string &path)
+    {
+      std::vector<uint8_t> content;
+      if (!readFile(path, content) || content.size() < 12 ||
+          memcmp(&content[0], "RIFF", 4) != 0 || memcmp(&content[8], "WAVE", 4) != 0)
+      {
+        return false;
+      }
+
+      uint16_t format = 0, channels = 0, bitsPerSample = 0;
+      uint32_t rate = 0;
+      size_t pos = 12;
+      while (pos + 8 <= content.size())
+      {
+        const uint32_t chunkSize = readLE(&content[pos + 4], 4);
+        const size_t chunkData = pos + 8;
+        const size_t chunkEnd = min(chunkData + chunkSize, content.size());
+
+        if (memcmp(&content[pos], "fmt ", 4) == 0 && chunkSize >= 16 && chunkEnd >= chunkData + 16)
+        {
+          format = readLE(&content[chunkData], 2);
+          channels = readLE(&content[chunkData + 2], 2);
+          rate = readLE(&content[chunkData + 4], 4);
+          bitsPerSample = readLE(&content[chunkData + 14], 2);
+          if (format == 0xFFFE && chunkSize >= 26)
+          {
+            // WAVE_FORMAT_EXTENSIBLE: the actual format is in the sub-format GUID
+            format = readLE(&content[chunkData + 24], 2);
+          }
+        }
+        else if (memcmp(&content[pos], "data", 4) == 0 && channels)
+        {
+          sampleRate = rate;
+          return decode(&content[chunkData], chunkEnd - chunkData, format, channels, bitsPerSample);
+        }
+        pos = chunkData + chunkSize + (chunkSize & 1);
+      }
+      return false;
+    }
+
+    /** Load a raw PCM file with signed 16 bit mono samples (little endian).
+     * @param path  The file.
+     * @param rate  Samples per second.
+     */
+    bool loadRaw(const std::string &path, uint32_t rate)
+    {
+      std::vector<uint8_t> content;
+      if (!readFile(path, content) || rate == 0)
+      {
+        return false;
+      }
+      sampleRate = rate;
+      return decode(content.data(), content.size(), 1, 1, 16);
+    }
+
+    /// Load a WAV file, or a raw PCM file (with the given \a rawRate) if it's not a WAV file.
+    bool load(const std::string &path, uint32_t rawRate = 44100)
+    {
+      return loadWav(path) || loadRaw(path, rawRate);
+    }
+
+    /// Duration of the audio (in µs).
+    uint64_t durationMicros() const
+    {
+      return sampleRate ? uint64_t(samples.size()) * 1000000 / sampleRate : 0;
+    }
+
+    /** Get the sample at the given time.
+     * @param micros  Time since start of the audio (in µs).
+     * @return The sample; 0 (silence) after the end, unless looping.
+     */
+    int16_t sampleAt(uint64_t micros) const
+    {
+      if (samples.empty())
+      {
+        return 0;
+      }
+      uint64_t index = micros * sampleRate / 1000000;
+      if (index >= samples.size())
+      {
+        if (!loop)
+        {
+          return 0;
+        }
+        index %= samples.size();
+      }
+      return samples[index];
+    }
+
+  private:
+    static bool readFile(const std::string &path, std::vector<uint8_t> &content)
+    {
+      FILE *file = fopen(path.c_str(), "rb");
+      if (!file)
+      {
+        return false;
+      }
+      uint8_t buffer[4096];
+      size_t count;
+      while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0)
+      {
+        content.insert(content.end(), buffer, buffer + count);
+      }
+      fclose(file);
+      return true;
+    }
+
+    static uint32_t readLE(const uint8_t *data, uint8_t bytes)
+    {
+      uint32_t value = 0;
+      for (uint8_t i = 0; i < bytes; ++i)
+      {
+        value |= uint32_t(data[i]) << (8 * i);
+      }
+      return value;
+    }
+
+    /// Convert one sample to signed 16 bit.
+    static int16_t toInt16(const uint8_t *data, uint16_t format, uint16_t bitsPerSample)
+    {
+      if (format == 3 && bitsPerSample == 32)
+      {
+        float value;
+        const uint32_t bits = readLE(data, 4);
+        memcpy(&value, &bits, sizeof(value));
+        return int16_t(constrain(value, -1.0f, 1.0f) * 32767);
+      }
+      switch (bitsPerSample)
+      {
+      case 8:
+        return int16_t((int16_t(data[0]) - 128) << 8);
+      case 16:
+        return int16_t(readLE(data, 2));
+      default:
+        // 24 and 32 bit: just the upper 16 bits
+        return int16_t(readLE(data + bitsPerSample / 8 - 2, 2));
+      }
+    }
+
+    bool decode(const uint8_t *data, size_t size, uint16_t format, uint16_t channels, uint16_t bitsPerSample)
+    {
+      const bool supportedPcm = (format == 1) && (bitsPerSample == 8 || bitsPerSample == 16 ||
+                                                  bitsPerSample == 24 || bitsPerSample == 32);
+      const bool supportedFloat = (format == 3) && (bitsPerSample == 32);
+      if (!(supportedPcm || supportedFloat) || channels == 0 || sampleRate == 0)
+      {
+        return false;
+      }
+
+      const size_t bytesPerSample = bitsPerSample / 8;
+      const size_t frameSize = bytesPerSample * channels;
+      samples.clear();
+      samples.reserve(size / frameSize);
+      for (size_t pos = 0; pos + frameSize <= size; pos += frameSize)
+      {
+        int32_t mixed = 0;
+        for (uint16_t channel = 0; channel < channels; ++channel)
+        {
+          mixed += toInt16(data + pos + channel * bytesPerSample, format, bitsPerSample);
+        }
+        samples.push_back(int16_t(mixed / channels));
+      }
+      return !samples.empty();
+    }
+  };
+
+  //------------------------------------------------------------------------------
+
+  /** An Animation-Worker for calculating the current VU level from an AudioFile.
+   * Works exactly like VuAnalogInputPin, but instead of calling analogRead(), it
+   * takes the sample of the AudioFile at the current time of micros() (which follows
+   * the simulated clock when enabled) and converts it to a 10 bit ADC value. \n
+   * Thus VU Animations get a reproducible audio input.
+   */
+  class VuAudioFile
+      : public Animation
+  {
+  public:
+    /** Usually there's nothing to configure here.
+     * Publicly accessible mainly for debugging.
+     */
+    VuLevelHandler vuLevelHandler;
+
+    /** Usually there's nothing to configure here.
+     * Publicly accessible mainly for debugging.
+     */
+    VuRangeExtender vuRangeExtender;
+
+    /** Amplification of the samples before converting them to ADC values.
+     * With 1.0, the full range of the AudioFile corresponds to the full range of the ADC.
+     */
+    float gain = 1.0;
+
+    /// Make this class usable as a VuSource.
+    operator VuSource &() { return asVuSource(); }
+    VuSource &asVuSource() { return vuRangeExtender; }
+
+    /** Constructor.
+     * @param audioFile  The audio samples; must outlive this object.
+     * @param sampleCount  Number of audio samples to integrate for calculating the VU level.
+     */
+    explicit VuAudioFile(const AudioFile &audioFile,
+                         uint16_t sampleCount = 100)
+        : vuLevelHandler(sampleCount),
+          _audioFile(audioFile)
+    {
+    }
+
+    /// Current sample of the AudioFile as ADC value (like from analogRead()).
+    uint16_t readAdc()
+    {
+      const uint32_t now = micros();
+      if (!_started)
+      {
+        _started = true;
+        _lastMicros = now;
+      }
+      // Works also when micros() overflows
+      _elapsedMicros += uint32_t(now - _lastMicros);
+      _lastMicros = now;
+
+      const float adcValue = 512.0 + _audioFile.sampleAt(_elapsedMicros) * gain / 64.0;
+      return uint16_t(constrain(adcValue, 0.0, 1023.0));
+    }
+
+  private:
+    /// @see Animation::processAnimation()
+    void processAnimation(uint32_t currentMillis, bool &wasModified) override
+    {
+      const float audioSample = _adcNormalizer.process(readAdc());
+      vuLevelHandler.addSample(audioSample);
+
+      if (wasModified)
+      {
+        vuRangeExtender.process(vuLevelHandler.capture());
+      }
+    }
+
+  private:
+    const AudioFile &_audioFile;
+    AdcSampleNormalizer _adcNormalizer;
+    uint64_t _elapsedMicros = 0;
+    uint32_t _lastMicros = 0;
+    bool _started = false;
+  };
+
+} // namespace EC
+
+//------------------------------------------------------------------------------